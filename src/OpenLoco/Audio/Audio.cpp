@@ -211,7 +211,7 @@ namespace OpenLoco::Audio
 
     static std::vector<Sample> loadSoundsFromCSS(const fs::path& path)
     {
-        Console::logVerbose("loadSoundsFromCSS(%s)", path.string().c_str());
+        Console::logVerbose(Console::Category::audio, "loadSoundsFromCSS(%s)", path.string().c_str());
         std::vector<Sample> results;
         std::ifstream fs(path, std::ios::in | std::ios::binary);
 
@@ -580,7 +580,7 @@ namespace OpenLoco::Audio
     {
         if (v->var_4A & 1)
         {
-            Console::logVerbose("playSound(vehicle #%d)", v->id);
+            Console::logVerbose(Console::Category::audio, "playSound(vehicle #%d)", v->id);
             auto vc = getFreeVehicleChannel();
             if (vc != nullptr)
             {
@@ -678,7 +678,7 @@ namespace OpenLoco::Audio
 
     static void mixSound(SoundId id, bool loop, int32_t volume, int32_t pan, int32_t freq)
     {
-        Console::logVerbose("mixSound(%d, %s, %d, %d, %d)", (int32_t)id, loop ? "true" : "false", volume, pan, freq);
+        Console::logVerbose(Console::Category::audio, "mixSound(%d, %s, %d, %d, %d)", (int32_t)id, loop ? "true" : "false", volume, pan, freq);
         auto sample = getSoundSample(id);
         if (sample != nullptr && sample->chunk != nullptr)
         {
@@ -699,7 +699,7 @@ namespace OpenLoco::Audio
 
     static bool loadChannel(ChannelId id, const fs::path& path, int32_t c)
     {
-        Console::logVerbose("loadChannel(%d, %s, %d)", id, path.string().c_str(), c);
+        Console::logVerbose(Console::Category::audio, "loadChannel(%d, %s, %d)", id, path.string().c_str(), c);
         if (isMusicChannel(id))
         {
             if (_music_channel.load(path))
@@ -729,7 +729,7 @@ namespace OpenLoco::Audio
     // 0x00401999
     bool playChannel(ChannelId id, int32_t loop, int32_t volume, int32_t d, int32_t freq)
     {
-        Console::logVerbose("playChannel(%d, %d, %d, %d, %d)", id, loop, volume, d, freq);
+        Console::logVerbose(Console::Category::audio, "playChannel(%d, %d, %d, %d, %d)", id, loop, volume, d, freq);
         if (isMusicChannel(id))
         {
             if (_music_channel.play(loop != 0))
@@ -753,7 +753,7 @@ namespace OpenLoco::Audio
     // 0x00401A05
     void stopChannel(ChannelId id)
     {
-        Console::logVerbose("stopChannel(%d)", id);
+        Console::logVerbose(Console::Category::audio, "stopChannel(%d)", id);
         if (isMusicChannel(id))
         {
             if (_music_current_channel == id)
@@ -774,7 +774,7 @@ namespace OpenLoco::Audio
     // 0x00401AD3
     void setChannelVolume(ChannelId id, int32_t volume)
     {
-        Console::logVerbose("setChannelVolume(%d, %d)", id, volume);
+        Console::logVerbose(Console::Category::audio, "setChannelVolume(%d, %d)", id, volume);
         if (isMusicChannel(id))
         {
             if (_music_current_channel == id)
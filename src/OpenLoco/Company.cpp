@@ -1,4 +1,5 @@
 #include "Company.h"
+#include "CompanyManager.h"
 #include "Entities/EntityManager.h"
 #include "Graphics/Gfx.h"
 #include "Interop/Interop.hpp"
@@ -9,6 +10,7 @@
 #include "Vehicles/Vehicle.h"
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <map>
 
 using namespace OpenLoco::Interop;
@@ -45,23 +47,31 @@ namespace OpenLoco
         call(0x00430762, regs);
     }
 
-    // 0x00437ED0
-    void Company::recalculateTransportCounts()
+#if DEBUG
+    // Counts the company's vehicles by scanning every vehicle, used to validate the cached counts
+    static std::array<uint16_t, 6> scanTransportCounts(CompanyId_t companyId)
     {
-        // Reset all counts to 0
-        for (auto& count : transportTypeCount)
-        {
-            count = 0;
-        }
-
-        auto companyId = id();
+        std::array<uint16_t, 6> counts{};
         for (auto v : EntityManager::VehicleList())
         {
             if (v->owner == companyId)
             {
-                transportTypeCount[static_cast<uint8_t>(v->vehicleType)]++;
+                counts[static_cast<uint8_t>(v->vehicleType)]++;
             }
         }
+        return counts;
+    }
+#endif
+
+    // 0x00437ED0
+    void Company::recalculateTransportCounts()
+    {
+        auto companyId = id();
+        const auto& counts = CompanyManager::getVehicleCounts(companyId);
+#if DEBUG
+        assert(counts == scanTransportCounts(companyId));
+#endif
+        std::copy(counts.begin(), counts.end(), std::begin(transportTypeCount));
 
         Ui::WindowManager::invalidate(Ui::WindowType::company, companyId);
     }
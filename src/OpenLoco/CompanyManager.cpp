@@ -1,5 +1,6 @@
 #include "CompanyManager.h"
 #include "Config.h"
+#include "Console.h"
 #include "Entities/EntityManager.h"
 #include "Entities/Misc.h"
 #include "GameCommands/GameCommands.h"
@@ -11,6 +12,8 @@
 #include "Ui/WindowManager.h"
 #include "Vehicles/Vehicle.h"
 #include "Vehicles/VehicleManager.h"
+#include <algorithm>
+#include <chrono>
 
 using namespace OpenLoco::Interop;
 using namespace OpenLoco::Ui;
@@ -25,12 +28,35 @@ namespace OpenLoco::CompanyManager
     static loco_global<uint8_t[max_companies + 1], 0x009C645C> _company_colours;
     static loco_global<CompanyId_t, 0x009C68EB> _updating_company_id;
 
+    static loco_global<uint8_t, 0x00508F08> _gameCommandNestLevel;
+
+    // Time an AI company may spend in a single think before it is reported as over budget
+    constexpr uint32_t aiThinkBudgetMicroseconds = 2000;
+
+    // Reported through logAiThinkStats
+    struct AiThinkStats
+    {
+        uint32_t thinks;
+        uint32_t overBudget;
+        uint32_t maxMicroseconds;
+        uint64_t totalMicroseconds;
+    };
+
+    static std::array<AiThinkStats, max_companies> _aiThinkStats;
+
+    static std::array<std::array<uint16_t, 6>, max_companies> _vehicleCounts;
+    static std::array<uint16_t, 6> _vehiclesOnMap;
+    static bool _vehicleCountsValid = false;
+
     static void produceCompanies();
+    static void resetAiThinkStats();
 
     // 0x0042F7F8
     void reset()
     {
         call(0x0042F7F8);
+        resetAiThinkStats();
+        invalidateVehicleCounts();
     }
 
     CompanyId_t updatingCompanyId()
@@ -93,6 +119,27 @@ namespace OpenLoco::CompanyManager
         return _company_colours[_player_company[0]];
     }
 
+    // Each AI company thinks on one of 16 tick slots and every think advances the original AI state machine
+    // by one step. A step is timed so that companies whose planning steps stall the tick can be found.
+    static void aiThink(Company& company)
+    {
+        const auto startTime = std::chrono::high_resolution_clock::now();
+        company.aiThink();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - startTime);
+
+        const auto id = company.id();
+        const auto microseconds = static_cast<uint32_t>(elapsed.count());
+        auto& stats = _aiThinkStats[id];
+        stats.thinks++;
+        stats.maxMicroseconds = std::max(stats.maxMicroseconds, microseconds);
+        stats.totalMicroseconds += microseconds;
+        if (microseconds > aiThinkBudgetMicroseconds)
+        {
+            stats.overBudget++;
+            Console::logVerbose("AI company %u think took %u us, over its budget of %u us", id, microseconds, aiThinkBudgetMicroseconds);
+        }
+    }
+
     // 0x00430319
     void update()
     {
@@ -103,7 +150,7 @@ namespace OpenLoco::CompanyManager
             if (company != nullptr && !isPlayerCompany(id) && !company->empty())
             {
                 updatingCompanyId(id);
-                company->aiThink();
+                aiThink(*company);
             }
 
             _byte_525FCB++;
@@ -124,6 +171,80 @@ namespace OpenLoco::CompanyManager
         }
     }
 
+    static void resetAiThinkStats()
+    {
+        _aiThinkStats = {};
+    }
+
+    void logAiThinkStats()
+    {
+        Console::logVerbose("AI think time per company (thinks, average us, max us, over budget):");
+        for (const auto& company : companies())
+        {
+            const auto& stats = _aiThinkStats[company.id()];
+            if (stats.thinks == 0)
+                continue;
+
+            Console::logVerbose(
+                "  %2u: %8u %8u %8u %8u",
+                company.id(),
+                stats.thinks,
+                static_cast<uint32_t>(stats.totalMicroseconds / stats.thinks),
+                stats.maxMicroseconds,
+                stats.overBudget);
+        }
+    }
+
+    // Counts every company's vehicles, and the vehicles placed on the map, in one pass over the vehicle list.
+    // The counts are a cache that is thrown away each tick and whenever vehicles may have changed.
+    static void updateVehicleCounts()
+    {
+        _vehicleCounts = {};
+        _vehiclesOnMap = {};
+
+        for (auto* vehicle : EntityManager::VehicleList())
+        {
+            const auto vehicleType = static_cast<uint8_t>(vehicle->vehicleType);
+            if (vehicle->owner < max_companies)
+            {
+                _vehicleCounts[vehicle->owner][vehicleType]++;
+            }
+
+            if (!(vehicle->var_38 & (1 << 4)) && vehicle->position.x != Location::null)
+            {
+                _vehiclesOnMap[vehicleType]++;
+            }
+        }
+
+        // Vehicles change inside game commands, so the counts are only kept between them
+        _vehicleCountsValid = _gameCommandNestLevel == 0;
+    }
+
+    // Vehicles owned by the company by VehicleType
+    const std::array<uint16_t, 6>& getVehicleCounts(CompanyId_t id)
+    {
+        if (!_vehicleCountsValid)
+        {
+            updateVehicleCounts();
+        }
+        return _vehicleCounts[id];
+    }
+
+    // Vehicles currently placed on the map by VehicleType
+    const std::array<uint16_t, 6>& getVehiclesOnMap()
+    {
+        if (!_vehicleCountsValid)
+        {
+            updateVehicleCounts();
+        }
+        return _vehiclesOnMap;
+    }
+
+    void invalidateVehicleCounts()
+    {
+        _vehicleCountsValid = false;
+    }
+
     static void sub_42F9AC()
     {
         call(0x0042F9AC);
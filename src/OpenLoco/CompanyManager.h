@@ -26,6 +26,10 @@ namespace OpenLoco::CompanyManager
     uint8_t getPlayerCompanyColour();
     void update();
     void updateQuarterly();
+    void logAiThinkStats();
+    const std::array<uint16_t, 6>& getVehicleCounts(CompanyId_t id);
+    const std::array<uint16_t, 6>& getVehiclesOnMap();
+    void invalidateVehicleCounts();
     void determineAvailableVehicles();
     currency32_t calculateDeliveredCargoPayment(uint8_t cargoItem, int32_t numUnits, int32_t distance, uint16_t numDays);
 
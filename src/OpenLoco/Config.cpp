@@ -94,10 +94,22 @@ namespace OpenLoco::Config
             _new_config.autosave_frequency = config["autosave_frequency"].as<int32_t>();
         if (config["autosave_amount"])
             _new_config.autosave_amount = config["autosave_amount"].as<int32_t>();
+        if (config["autosave_deltas"])
+            _new_config.autosave_deltas = config["autosave_deltas"].as<bool>();
+        if (config["autosave_rebase_interval"])
+            _new_config.autosave_rebase_interval = config["autosave_rebase_interval"].as<int32_t>();
+        if (config["autosave_lz_compression"])
+            _new_config.autosave_lz_compression = config["autosave_lz_compression"].as<bool>();
         if (config["showFPS"])
             _new_config.showFPS = config["showFPS"].as<bool>();
         if (config["uncapFPS"])
             _new_config.uncapFPS = config["uncapFPS"].as<bool>();
+        if (config["profileInterop"])
+            _new_config.profileInterop = config["profileInterop"].as<bool>();
+        if (config["verboseLogging"])
+            _new_config.verboseLogging = config["verboseLogging"].as<bool>();
+        if (config["logToFile"])
+            _new_config.logToFile = config["logToFile"].as<bool>();
 
         return _new_config;
     }
@@ -147,8 +159,14 @@ namespace OpenLoco::Config
         node["zoom_to_cursor"] = _new_config.zoom_to_cursor;
         node["autosave_frequency"] = _new_config.autosave_frequency;
         node["autosave_amount"] = _new_config.autosave_amount;
+        node["autosave_deltas"] = _new_config.autosave_deltas;
+        node["autosave_rebase_interval"] = _new_config.autosave_rebase_interval;
+        node["autosave_lz_compression"] = _new_config.autosave_lz_compression;
         node["showFPS"] = _new_config.showFPS;
         node["uncapFPS"] = _new_config.uncapFPS;
+        node["profileInterop"] = _new_config.profileInterop;
+        node["verboseLogging"] = _new_config.verboseLogging;
+        node["logToFile"] = _new_config.logToFile;
 
         std::ofstream stream(configPath);
         if (stream.is_open())
@@ -160,8 +160,14 @@ namespace OpenLoco::Config
         bool zoom_to_cursor = true;
         int32_t autosave_frequency = 1;
         int32_t autosave_amount = 12;
+        bool autosave_deltas = false;
+        int32_t autosave_rebase_interval = 6;
+        bool autosave_lz_compression = false;
         bool showFPS = false;
         bool uncapFPS = false;
+        bool profileInterop = false;
+        bool verboseLogging = false;
+        bool logToFile = false;
     };
 
     LocoConfig& get();
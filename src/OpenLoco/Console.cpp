@@ -1,61 +1,379 @@
 #include "Console.h"
+#include "Core/FileSystem.hpp"
 #include "Utility/String.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
 #include <stdarg.h>
+#include <string>
+#include <thread>
 
 namespace OpenLoco::Console
 {
-    static int _group = 0;
+    using Clock = std::chrono::steady_clock;
 
-    static void vwrite(FILE* buffer, const char* format, va_list args)
+    struct Message
     {
-        for (int i = 0; i < _group; i++)
+        std::atomic<size_t> sequence;
+        uint32_t tick;
+        Clock::time_point time;
+        Level level;
+        char text[512];
+    };
+
+    /**
+     * Bounded multi-producer single-consumer queue of log messages, written out by a background thread.
+     * Producers claim a slot with a single compare and swap and format straight into it. When the queue
+     * is full, errors wait for a free slot and all other messages are dropped and counted. Errors are
+     * written out on the thread that logs them, so they survive a crash or exit that follows.
+     */
+    class Logger
+    {
+    public:
+        static constexpr size_t capacity = 4096;
+
+        Logger()
+            : _startTime(Clock::now())
+        {
+            for (size_t i = 0; i < capacity; i++)
+            {
+                _messages[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _writer = std::thread([this]() { writerLoop(); });
+        }
+
+        ~Logger()
+        {
+            _stopping = true;
+            _wake.notify_one();
+            _writer.join();
+        }
+
+        void write(Level level, int indent, const char* prefix, const char* format, va_list args)
+        {
+            auto* message = claim(level == Level::error);
+            if (message == nullptr)
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            message->tick = _tick.load(std::memory_order_relaxed);
+            message->time = Clock::now();
+            message->level = level;
+
+            size_t length = 0;
+            for (int i = 0; i < indent && length + 2 < sizeof(message->text); i++)
+            {
+                message->text[length++] = ' ';
+                message->text[length++] = ' ';
+            }
+            message->text[length] = '\0';
+            Utility::strlcat(message->text, prefix, sizeof(message->text));
+            length = std::strlen(message->text);
+            std::vsnprintf(message->text + length, sizeof(message->text) - length, format, args);
+
+            publish(message);
+            if (level == Level::error)
+            {
+                flush();
+            }
+        }
+
+        // Writes every message queued so far on the calling thread. Gives up after a second if the writer
+        // thread holds on to the queue, as the caller may be handling a crash of that thread.
+        void flush()
+        {
+            std::unique_lock<std::timed_mutex> lock(_drainMutex, std::chrono::seconds(1));
+            if (lock.owns_lock())
+            {
+                drain();
+            }
+        }
+
+        void setTick(uint32_t tick)
+        {
+            _tick.store(tick, std::memory_order_relaxed);
+        }
+
+        void openFile(const char* path, size_t maxFileSize, size_t maxFiles)
         {
-            fprintf(buffer, "  ");
+            std::lock_guard<std::mutex> lock(_fileMutex);
+            _filePath = fs::u8path(path);
+            _maxFileSize = maxFileSize;
+            _maxFiles = maxFiles;
+            rotateFile();
         }
 
-        vprintf(format, args);
-        fprintf(buffer, "\n");
+    private:
+        std::array<Message, capacity> _messages;
+        std::atomic<size_t> _enqueuePos{ 0 };
+        std::atomic<size_t> _dequeuePos{ 0 };
+        std::atomic<size_t> _dropped{ 0 };
+        std::atomic<uint32_t> _tick{ 0 };
+        std::atomic<bool> _stopping{ false };
+        Clock::time_point _startTime;
+
+        std::thread _writer;
+        std::mutex _wakeMutex;
+        std::condition_variable _wake;
+        std::timed_mutex _drainMutex;
+
+        std::mutex _fileMutex;
+        fs::path _filePath;
+        std::ofstream _file;
+        size_t _fileSize = 0;
+        size_t _maxFileSize = 0;
+        size_t _maxFiles = 0;
+
+        Message* claim(bool wait)
+        {
+            auto pos = _enqueuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto* message = &_messages[pos % capacity];
+                const auto sequence = message->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        return message;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // Queue is full
+                    if (!wait)
+                    {
+                        return nullptr;
+                    }
+                    _wake.notify_one();
+                    std::this_thread::yield();
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+                else
+                {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void publish(Message* message)
+        {
+            const auto pos = message->sequence.load(std::memory_order_relaxed);
+            message->sequence.store(pos + 1, std::memory_order_release);
+        }
+
+        void writerLoop()
+        {
+            for (;;)
+            {
+                const bool stopping = _stopping;
+                bool wroteAny;
+                {
+                    std::lock_guard<std::timed_mutex> lock(_drainMutex);
+                    wroteAny = drain();
+                }
+                if (!wroteAny)
+                {
+                    if (stopping)
+                    {
+                        break;
+                    }
+                    std::unique_lock<std::mutex> lock(_wakeMutex);
+                    _wake.wait_for(lock, std::chrono::milliseconds(20));
+                }
+            }
+        }
+
+        bool drain()
+        {
+            bool wroteAny = false;
+            auto pos = _dequeuePos.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& message = _messages[pos % capacity];
+                if (message.sequence.load(std::memory_order_acquire) != pos + 1)
+                {
+                    break;
+                }
+
+                writeMessage(message);
+                message.sequence.store(pos + capacity, std::memory_order_release);
+                pos++;
+                _dequeuePos.store(pos, std::memory_order_release);
+                wroteAny = true;
+            }
+
+            const auto dropped = _dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped != 0)
+            {
+                std::fprintf(stderr, "%zu log messages dropped\n", dropped);
+                std::lock_guard<std::mutex> fileLock(_fileMutex);
+                if (_file.is_open())
+                {
+                    _file << dropped << " log messages dropped\n";
+                }
+            }
+
+            if (wroteAny)
+            {
+                std::fflush(stdout);
+                std::lock_guard<std::mutex> fileLock(_fileMutex);
+                if (_file.is_open())
+                {
+                    _file.flush();
+                }
+            }
+
+            return wroteAny;
+        }
+
+        void writeMessage(const Message& message)
+        {
+            auto* stream = message.level == Level::error ? stderr : stdout;
+            std::fprintf(stream, "%s\n", message.text);
+
+            std::lock_guard<std::mutex> lock(_fileMutex);
+            if (!_file.is_open())
+            {
+                return;
+            }
+
+            const auto seconds = std::chrono::duration<double>(message.time - _startTime).count();
+            char header[48];
+            const auto headerLength = std::snprintf(header, sizeof(header), "[%10.3f #%-8u] ", seconds, message.tick);
+            _file << header << message.text << '\n';
+            _fileSize += headerLength + std::strlen(message.text) + 1;
+            if (_fileSize >= _maxFileSize)
+            {
+                rotateFile();
+            }
+        }
+
+        static fs::path getRotatedPath(const fs::path& path, size_t index)
+        {
+            auto result = path;
+            result.replace_extension("." + std::to_string(index) + path.extension().u8string());
+            return result;
+        }
+
+        // Moves openloco.log to openloco.1.log and so on, keeping at most _maxFiles old logs
+        void rotateFile()
+        {
+            _file.close();
+            _fileSize = 0;
+
+            std::error_code ec;
+            if (_maxFiles > 0 && fs::exists(_filePath, ec))
+            {
+                fs::remove(getRotatedPath(_filePath, _maxFiles), ec);
+                for (auto i = _maxFiles; i > 1; i--)
+                {
+                    auto from = getRotatedPath(_filePath, i - 1);
+                    if (fs::exists(from, ec))
+                    {
+                        fs::rename(from, getRotatedPath(_filePath, i), ec);
+                    }
+                }
+                fs::rename(_filePath, getRotatedPath(_filePath, 1), ec);
+            }
+
+            _file.open(_filePath, std::ios::out | std::ios::trunc);
+        }
+    };
+
+    static Logger& getLogger()
+    {
+        static Logger logger;
+        return logger;
+    }
+
+    static std::atomic<int> _group = 0;
+
+#ifdef VERBOSE
+    constexpr Level defaultLevel = Level::verbose;
+#else
+    constexpr Level defaultLevel = Level::info;
+#endif
+    static std::array<std::atomic<Level>, static_cast<size_t>(Category::count)> _levels = {
+        defaultLevel,
+        defaultLevel,
+        defaultLevel,
+        defaultLevel,
+    };
+
+    static void vwrite(Category category, Level level, const char* format, va_list args)
+    {
+        if (!isEnabled(category, level))
+            return;
+
+        getLogger().write(level, _group, "", format, args);
     }
 
     void log(const char* format, ...)
     {
         va_list args;
         va_start(args, format);
-        vwrite(stdout, format, args);
+        vwrite(Category::general, Level::info, format, args);
+        va_end(args);
+    }
+
+    void log(Category category, const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        vwrite(category, Level::info, format, args);
         va_end(args);
     }
 
     void logVerbose(const char* format, ...)
     {
-#ifdef VERBOSE
         va_list args;
         va_start(args, format);
-        vwrite(stdout, format, args);
+        vwrite(Category::general, Level::verbose, format, args);
         va_end(args);
-#endif
     }
 
-    void error(const char* format, ...)
+    void logVerbose(Category category, const char* format, ...)
     {
         va_list args;
         va_start(args, format);
-        vwrite(stderr, format, args);
+        vwrite(category, Level::verbose, format, args);
         va_end(args);
     }
 
-    void group(const char* format, ...)
+    void error(const char* format, ...)
     {
-        for (int i = 0; i < _group; i++)
-        {
-            printf("  ");
-        }
+        va_list args;
+        va_start(args, format);
+        vwrite(Category::general, Level::error, format, args);
+        va_end(args);
+    }
 
-        printf("> ");
+    void error(Category category, const char* format, ...)
+    {
         va_list args;
         va_start(args, format);
-        vprintf(format, args);
+        vwrite(category, Level::error, format, args);
         va_end(args);
-        printf("\n");
+    }
+
+    void group(const char* format, ...)
+    {
+        if (isEnabled(Category::general, Level::info))
+        {
+            va_list args;
+            va_start(args, format);
+            getLogger().write(Level::info, _group, "> ", format, args);
+            va_end(args);
+        }
 
         _group++;
     }
@@ -64,4 +382,43 @@ namespace OpenLoco::Console
     {
         _group--;
     }
+
+    void setLevel(Category category, Level level)
+    {
+        _levels[static_cast<size_t>(category)].store(level, std::memory_order_relaxed);
+    }
+
+    void setLevel(Level level)
+    {
+        for (auto& categoryLevel : _levels)
+        {
+            categoryLevel.store(level, std::memory_order_relaxed);
+        }
+    }
+
+    Level getLevel(Category category)
+    {
+        return _levels[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    bool isEnabled(Category category, Level level)
+    {
+        return level <= getLevel(category);
+    }
+
+    // Tick number written alongside each message in the log file
+    void setTick(uint32_t tick)
+    {
+        getLogger().setTick(tick);
+    }
+
+    void openLogFile(const char* path, size_t maxFileSize, size_t maxFiles)
+    {
+        getLogger().openFile(path, maxFileSize, maxFiles);
+    }
+
+    void flush()
+    {
+        getLogger().flush();
+    }
 }
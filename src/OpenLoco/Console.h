@@ -1,11 +1,43 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace OpenLoco::Console
 {
+    enum class Category : uint8_t
+    {
+        general,
+        audio,
+        interop,
+        graphics,
+        count,
+    };
+
+    enum class Level : uint8_t
+    {
+        none,
+        error,
+        info,
+        verbose,
+    };
+
     void log(const char* format, ...);
+    void log(Category category, const char* format, ...);
     void logVerbose(const char* format, ...);
+    void logVerbose(Category category, const char* format, ...);
     void error(const char* format, ...);
+    void error(Category category, const char* format, ...);
 
     void group(const char* format, ...);
     void groupEnd();
+
+    void setLevel(Category category, Level level);
+    void setLevel(Level level);
+    Level getLevel(Category category);
+    bool isEnabled(Category category, Level level);
+
+    void setTick(uint32_t tick);
+    void openLogFile(const char* path, size_t maxFileSize = 8 * 1024 * 1024, size_t maxFiles = 5);
+    void flush();
 }
@@ -152,6 +152,10 @@ namespace OpenLoco::Drawing
     {
         auto max = Rect(0, 0, Ui::width(), Ui::height());
         auto rect = _rect.intersection(max);
+        if (!_rect.intersects(max))
+            return;
+
+        _drawnRects.push_back(rect);
 
         registers regs;
         regs.ax = rect.left();
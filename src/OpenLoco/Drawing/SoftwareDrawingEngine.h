@@ -4,6 +4,7 @@
 #include "../Ui/Rect.h"
 #include <algorithm>
 #include <cstddef>
+#include <vector>
 
 namespace OpenLoco::Drawing
 {
@@ -14,7 +15,13 @@ namespace OpenLoco::Drawing
         void drawRect(const Ui::Rect& rect);
         void setDirtyBlocks(int32_t left, int32_t top, int32_t right, int32_t bottom);
 
+        // Screen areas redrawn since the last present
+        const std::vector<Ui::Rect>& getDrawnRects() const { return _drawnRects; }
+        void clearDrawnRects() { _drawnRects.clear(); }
+
     private:
+        std::vector<Ui::Rect> _drawnRects;
+
         void drawDirtyBlocks(size_t x, size_t y, size_t dx, size_t dy);
     };
 }
@@ -1,4 +1,5 @@
 #include "EntityManager.h"
+#include "../CompanyManager.h"
 #include "../Console.h"
 #include "../Entities/Misc.h"
 #include "../GameCommands/GameCommands.h"
@@ -8,6 +9,7 @@
 #include "../OpenLoco.h"
 #include "../Vehicles/Vehicle.h"
 #include "EntityTweener.h"
+#include "ParticleManager.h"
 
 using namespace OpenLoco::Interop;
 
@@ -84,6 +86,7 @@ namespace OpenLoco::EntityManager
 
         resetSpatialIndex();
         EntityTweener::get().reset();
+        ParticleManager::reset();
     }
 
     EntityId_t firstId(EntityListType list)
@@ -188,7 +191,7 @@ namespace OpenLoco::EntityManager
         {
             return nullptr;
         }
-        if (getListCount(EntityListType::null) <= 0)
+        if (getListCount(EntityListType::null) <= numEntitiesReservedForVehicles)
         {
             return nullptr;
         }
@@ -274,6 +277,7 @@ namespace OpenLoco::EntityManager
             {
                 misc->update();
             }
+            ParticleManager::update();
         }
     }
 
@@ -341,6 +345,11 @@ namespace OpenLoco::EntityManager
 
         _listCounts[curList]--;
         _listCounts[static_cast<uint8_t>(list)]++;
+
+        if (list == EntityListType::vehicleHead || curList == static_cast<uint8_t>(EntityListType::vehicleHead))
+        {
+            CompanyManager::invalidateVehicleCounts();
+        }
     }
 
     // 0x00470188
@@ -20,6 +20,8 @@ namespace OpenLoco::EntityManager
     constexpr size_t maxNormalEntities = maxEntities - maxMoneyEntities;
     // Money is not counted in this limit
     constexpr size_t maxMiscEntities = 4000;
+    // Free entities kept back from misc entities so vehicles can still be built, the pool itself stays maxEntities
+    constexpr size_t numEntitiesReservedForVehicles = 500;
 
     enum class EntityListType
     {
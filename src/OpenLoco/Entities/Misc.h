@@ -67,8 +67,6 @@ namespace OpenLoco
         uint8_t object_id; // 0x49
 
         SteamObject* object() const;
-
-        static Exhaust* create(Map::Pos3 loc, uint8_t type);
     };
     static_assert(sizeof(Exhaust) == 0x4A);
 
@@ -129,8 +127,6 @@ namespace OpenLoco
     {
         uint8_t pad_24[0x28 - 0x24];
         uint16_t frame; // 0x28
-
-        static Smoke* create(Map::Pos3 loc);
     };
     static_assert(sizeof(Smoke) == 0x2A);
 #pragma pack(pop)
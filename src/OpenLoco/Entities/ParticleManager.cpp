@@ -0,0 +1,355 @@
+#include "ParticleManager.h"
+#include "../Config.h"
+#include "../Interop/Interop.hpp"
+#include "../Map/Tile.h"
+#include "../Map/TileManager.h"
+#include "../Objects/ObjectManager.h"
+#include "../Objects/SteamObject.h"
+#include "../Objects/TrainStationObject.h"
+#include "../ViewportManager.h"
+#include <algorithm>
+
+using namespace OpenLoco::Interop;
+using namespace OpenLoco::Ui;
+
+namespace OpenLoco::ParticleManager
+{
+    static loco_global<int32_t, 0x00E3F0B8> _currentRotation;
+
+    // Sprite extents around the particle position, as EntityBase::var_14, var_09 and var_15
+    struct SpriteBounds
+    {
+        uint8_t halfWidth;
+        uint8_t above;
+        uint8_t below;
+    };
+
+    constexpr SpriteBounds smokeBounds = { 44, 32, 34 };
+
+    // Sorted (tile, particle) pairs so painting can find the particles on a tile without a linked list per tile
+    class TileIndex
+    {
+    public:
+        void invalidate()
+        {
+            _dirty = true;
+        }
+
+        template<typename TParticles>
+        stdx::span<const uint16_t> find(const TParticles& particles, const Map::Pos2& loc)
+        {
+            if (_dirty)
+            {
+                rebuild(particles);
+            }
+
+            const auto key = getTileKey(loc.x, loc.y);
+            const auto range = std::equal_range(_keys.begin(), _keys.end(), key);
+            const auto offset = range.first - _keys.begin();
+            return stdx::span<const uint16_t>(_indices.data() + offset, range.second - range.first);
+        }
+
+    private:
+        std::vector<uint64_t> _entries;
+        std::vector<uint32_t> _keys;
+        std::vector<uint16_t> _indices;
+        bool _dirty = true;
+
+        static uint32_t getTileKey(coord_t x, coord_t y)
+        {
+            return (static_cast<uint32_t>(x & 0x3FE0) << 4) | (static_cast<uint32_t>(y & 0x3FE0) >> 5);
+        }
+
+        template<typename TParticles>
+        void rebuild(const TParticles& particles)
+        {
+            _entries.clear();
+            for (size_t i = 0; i < particles.size(); i++)
+            {
+                _entries.push_back((static_cast<uint64_t>(getTileKey(particles.x[i], particles.y[i])) << 16) | i);
+            }
+            std::sort(_entries.begin(), _entries.end());
+
+            _keys.resize(_entries.size());
+            _indices.resize(_entries.size());
+            for (size_t i = 0; i < _entries.size(); i++)
+            {
+                _keys[i] = static_cast<uint32_t>(_entries[i] >> 16);
+                _indices[i] = static_cast<uint16_t>(_entries[i]);
+            }
+            _dirty = false;
+        }
+    };
+
+    static ExhaustParticles _exhaust;
+    static SmokeParticles _smoke;
+    static TileIndex _exhaustTiles;
+    static TileIndex _smokeTiles;
+
+    static ViewportRect getSpriteRect(const Map::Pos3& loc, const SpriteBounds& bounds)
+    {
+        const auto pos = Map::coordinate3dTo2d(loc.x, loc.y, loc.z, _currentRotation);
+        ViewportRect rect;
+        rect.left = pos.x - bounds.halfWidth;
+        rect.top = pos.y - bounds.above;
+        rect.right = pos.x + bounds.halfWidth;
+        rect.bottom = pos.y + bounds.below;
+        return rect;
+    }
+
+    // Invalidates both the old and new sprite in one go, particles only ever move a few pixels per tick
+    static void invalidateMove(const Map::Pos3& from, const Map::Pos3& to, const SpriteBounds& bounds, ZoomLevel zoom)
+    {
+        const auto fromRect = getSpriteRect(from, bounds);
+        const auto toRect = getSpriteRect(to, bounds);
+        ViewportRect rect;
+        rect.left = std::min(fromRect.left, toRect.left);
+        rect.top = std::min(fromRect.top, toRect.top);
+        rect.right = std::max(fromRect.right, toRect.right);
+        rect.bottom = std::max(fromRect.bottom, toRect.bottom);
+
+        const auto level = static_cast<ZoomLevel>(std::min(Config::get().vehicles_min_scale, static_cast<uint8_t>(zoom)));
+        ViewportManager::invalidate(rect, level);
+    }
+
+    static void removeParticle(ExhaustParticles& particles, size_t index)
+    {
+        const auto last = particles.size() - 1;
+        particles.x[index] = particles.x[last];
+        particles.y[index] = particles.y[last];
+        particles.z[index] = particles.z[last];
+        particles.subX[index] = particles.subX[last];
+        particles.frame[index] = particles.frame[last];
+        particles.ticks[index] = particles.ticks[last];
+        particles.objectId[index] = particles.objectId[last];
+        particles.x.pop_back();
+        particles.y.pop_back();
+        particles.z.pop_back();
+        particles.subX.pop_back();
+        particles.frame.pop_back();
+        particles.ticks.pop_back();
+        particles.objectId.pop_back();
+    }
+
+    static void removeParticle(SmokeParticles& particles, size_t index)
+    {
+        const auto last = particles.size() - 1;
+        particles.x[index] = particles.x[last];
+        particles.y[index] = particles.y[last];
+        particles.z[index] = particles.z[last];
+        particles.frame[index] = particles.frame[last];
+        particles.x.pop_back();
+        particles.y.pop_back();
+        particles.z.pop_back();
+        particles.frame.pop_back();
+    }
+
+    void reset()
+    {
+        _exhaust = {};
+        _smoke = {};
+        _exhaustTiles.invalidate();
+        _smokeTiles.invalidate();
+    }
+
+    // 0x00440966
+    static bool hitsTileElement(const Map::Pos3& loc)
+    {
+        auto tile = Map::TileManager::get(loc.x, loc.y);
+        if (tile.isNull())
+        {
+            return false;
+        }
+
+        const uint8_t baseZ = static_cast<uint16_t>(loc.z) >> 2;
+        const uint8_t bottom = baseZ - 3;
+        const uint8_t top = baseZ + 3;
+        for (auto& el : tile)
+        {
+            if (el.isGhost() || el.isFlag5())
+            {
+                continue;
+            }
+            if (bottom < el.baseZ() && top > el.baseZ())
+            {
+                return true;
+            }
+
+            // Exhaust also hits the roof of a station built over the track
+            auto* track = el.asTrack();
+            if (track == nullptr || !track->hasStationElement())
+            {
+                continue;
+            }
+            auto* station = (&el + 1)->asStation();
+            if (station == nullptr || station->isGhost() || station->isFlag5())
+            {
+                continue;
+            }
+            auto* stationObj = ObjectManager::get<TrainStationObject>(station->objectId());
+            if ((stationObj->flags & (1 << 1)) || (station->data()[0] >> 6) == 0)
+            {
+                continue;
+            }
+            const uint8_t roofZ = el.baseZ() + 7;
+            if (bottom < roofZ && top > roofZ)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 0x004408C2
+    // Returns false once the particle should be removed
+    static bool updateExhaust(size_t i)
+    {
+        auto& particles = _exhaust;
+        const auto* obj = ObjectManager::get<SteamObject>(particles.objectId[i] & 0x7F);
+        const SpriteBounds bounds = { obj->var_05, obj->var_06, obj->var_07 };
+        const Map::Pos3 oldPos = { particles.x[i], particles.y[i], particles.z[i] };
+
+        bool changed = false;
+        if (obj->var_08 & SteamObjectFlags::applyWind)
+        {
+            const uint32_t subX = particles.subX[i] + 7000;
+            particles.subX[i] = static_cast<uint16_t>(subX);
+            if (subX > 0xFFFF)
+            {
+                particles.x[i]++;
+                changed = true;
+            }
+        }
+
+        bool alive = true;
+        particles.ticks[i]++;
+        if (particles.ticks[i] >= obj->var_04)
+        {
+            particles.ticks[i] = 0;
+            particles.frame[i]++;
+            changed = true;
+
+            const bool altFrames = (particles.objectId[i] & 0x80) != 0;
+            const auto numFrames = altFrames ? obj->var_14 : obj->var_12;
+            const auto* frames = altFrames ? obj->var_1A : obj->var_16;
+            if (particles.frame[i] >= numFrames)
+            {
+                alive = false;
+            }
+            else
+            {
+                particles.z[i] += static_cast<int8_t>(frames[particles.frame[i] * 2 + 1]);
+                if (obj->var_08 & SteamObjectFlags::disperseOnImpact)
+                {
+                    alive = !hitsTileElement({ particles.x[i], particles.y[i], particles.z[i] });
+                }
+            }
+        }
+
+        if (changed)
+        {
+            const Map::Pos3 newPos = { particles.x[i], particles.y[i], particles.z[i] };
+            invalidateMove(oldPos, newPos, bounds, ZoomLevel::eighth);
+            if ((oldPos.x & 0xFFE0) != (newPos.x & 0xFFE0))
+            {
+                _exhaustTiles.invalidate();
+            }
+        }
+        return alive;
+    }
+
+    // 0x004407A1
+    static bool updateSmoke(size_t i)
+    {
+        auto& particles = _smoke;
+        const Map::Pos3 oldPos = { particles.x[i], particles.y[i], particles.z[i] };
+        particles.z[i]++;
+        invalidateMove(oldPos, { oldPos.x, oldPos.y, particles.z[i] }, smokeBounds, ZoomLevel::half);
+
+        particles.frame[i] += 0x55;
+        return particles.frame[i] < 0xC00;
+    }
+
+    template<typename TParticles, typename TUpdate>
+    static void updateParticles(TParticles& particles, TileIndex& tiles, TUpdate&& updateParticle)
+    {
+        for (size_t i = 0; i < particles.size();)
+        {
+            if (updateParticle(i))
+            {
+                i++;
+                continue;
+            }
+            removeParticle(particles, i);
+            tiles.invalidate();
+        }
+    }
+
+    // Called each tick in place of MiscBase::update for exhaust and smoke entities
+    void update()
+    {
+        updateParticles(_exhaust, _exhaustTiles, updateExhaust);
+        updateParticles(_smoke, _smokeTiles, updateSmoke);
+    }
+
+    // 0x0044080C
+    bool createExhaust(const Map::Pos3& loc, uint8_t type)
+    {
+        if ((uint16_t)loc.x > 12287 || (uint16_t)loc.y > 12287)
+            return false;
+        auto surface = Map::TileManager::get(loc.x & 0xFFE0, loc.y & 0xFFE0).surface();
+
+        if (surface == nullptr)
+            return false;
+
+        if (loc.z <= surface->baseZ() * 4)
+            return false;
+
+        if (_exhaust.size() >= maxExhaustParticles)
+            return false;
+
+        _exhaust.x.push_back(loc.x);
+        _exhaust.y.push_back(loc.y);
+        _exhaust.z.push_back(loc.z);
+        _exhaust.subX.push_back(0);
+        _exhaust.frame.push_back(0);
+        _exhaust.ticks.push_back(0);
+        _exhaust.objectId.push_back(type);
+        _exhaustTiles.invalidate();
+        return true;
+    }
+
+    // 0x00440BEB
+    bool createSmoke(const Map::Pos3& loc)
+    {
+        if (_smoke.size() >= maxSmokeParticles)
+            return false;
+
+        _smoke.x.push_back(loc.x);
+        _smoke.y.push_back(loc.y);
+        _smoke.z.push_back(loc.z);
+        _smoke.frame.push_back(0);
+        _smokeTiles.invalidate();
+        return true;
+    }
+
+    const ExhaustParticles& getExhaust()
+    {
+        return _exhaust;
+    }
+
+    const SmokeParticles& getSmoke()
+    {
+        return _smoke;
+    }
+
+    stdx::span<const uint16_t> getExhaustOnTile(const Map::Pos2& loc)
+    {
+        return _exhaustTiles.find(_exhaust, loc);
+    }
+
+    stdx::span<const uint16_t> getSmokeOnTile(const Map::Pos2& loc)
+    {
+        return _smokeTiles.find(_smoke, loc);
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Core/Span.hpp"
+#include "../Map/Map.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace OpenLoco::ParticleManager
+{
+    // Exhaust and smoke are purely visual and short lived so they are kept out of the entity pool and
+    // not saved. Each kind has its own packed structure of arrays, removed particles are swapped with
+    // the last one.
+    constexpr size_t maxExhaustParticles = 16000;
+    constexpr size_t maxSmokeParticles = 2000;
+
+    struct ExhaustParticles
+    {
+        std::vector<int16_t> x;
+        std::vector<int16_t> y;
+        std::vector<int16_t> z;
+        std::vector<uint16_t> subX;    // Fractional x for drifting exhaust (Exhaust::var_32)
+        std::vector<uint16_t> frame;   // Index into the steam object frame table (Exhaust::var_26)
+        std::vector<uint8_t> ticks;    // Ticks spent on the current frame (Exhaust::var_28)
+        std::vector<uint8_t> objectId; // Steam object id, 0x80 selects the second frame table
+
+        size_t size() const { return x.size(); }
+    };
+
+    struct SmokeParticles
+    {
+        std::vector<int16_t> x;
+        std::vector<int16_t> y;
+        std::vector<int16_t> z;
+        std::vector<uint16_t> frame; // Image index in the upper byte (Smoke::frame)
+
+        size_t size() const { return x.size(); }
+    };
+
+    void reset();
+    void update();
+
+    bool createExhaust(const Map::Pos3& loc, uint8_t type);
+    bool createSmoke(const Map::Pos3& loc);
+
+    const ExhaustParticles& getExhaust();
+    const SmokeParticles& getSmoke();
+
+    // Indices of the exhaust and smoke particles on the tile containing loc, valid until the next update
+    stdx::span<const uint16_t> getExhaustOnTile(const Map::Pos2& loc);
+    stdx::span<const uint16_t> getSmokeOnTile(const Map::Pos2& loc);
+}
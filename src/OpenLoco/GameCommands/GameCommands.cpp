@@ -5,6 +5,7 @@
 #include "../Localisation/FormatArguments.hpp"
 #include "../Localisation/StringIds.h"
 #include "../Map/Tile.h"
+#include "../Map/TileManager.h"
 #include "../Objects/ObjectManager.h"
 #include "../Objects/RoadObject.h"
 #include "../Objects/TrackObject.h"
@@ -175,6 +176,9 @@ namespace OpenLoco::GameCommands
             return loc_4313C6(esi, regs);
         }
 
+        // Land may be modified by this command
+        Map::TileManager::invalidateHeightCache();
+
         if (commandRequiresUnpausingGame(command, flags) && _updating_company_id == _player_company[0])
         {
             if (getPauseFlags() & 1)
@@ -205,7 +209,9 @@ namespace OpenLoco::GameCommands
             call(0x0046E34A, fnRegs); // some network stuff. Untested
         }
 
-        return loc_4313C6(esi, regs);
+        auto result = loc_4313C6(esi, regs);
+        CompanyManager::invalidateVehicleCounts();
+        return result;
     }
 
     static void callGameCommandFunction(uint32_t command, registers& regs)
@@ -5,15 +5,18 @@
 #include "../Input.h"
 #include "../Interop/Interop.hpp"
 #include "../Localisation/LanguageFiles.h"
+#include "../Platform/Platform.h"
 #include "../Ui.h"
 #include "../Ui/WindowManager.h"
 #include "../Utility/Stream.hpp"
 #include "Colour.h"
 #include "ImageIds.h"
+#include "TextLayout.h"
 #include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -45,6 +48,7 @@ namespace OpenLoco::Gfx
 
     static loco_global<G1Element[g1_expected_count::disc + g1_count_temporary + g1_count_objects], 0x9E2424> _g1Elements;
 
+    static platform::MappedFile _g1File;
     static std::unique_ptr<std::byte[]> _g1Buffer;
     static loco_global<uint16_t[147], 0x050B8C8> _paletteToG1Offset;
 
@@ -154,33 +158,86 @@ namespace OpenLoco::Gfx
         return std::nullopt;
     }
 
-    static std::vector<G1Element> convertElements(const std::vector<G1Element32>& elements32)
+    // The steam G1.DAT is missing two localised tutorial icons, and a smaller font variant.
+    // Returns the index of the steam element to use in place of each disc element, substituting
+    // the closest variants for the missing ones.
+    static std::vector<uint32_t> getSteamElementRemap()
     {
-        auto elements = std::vector<G1Element>();
-        elements.reserve(elements32.size());
-        std::transform(
-            elements32.begin(),
-            elements32.end(),
-            std::back_inserter(elements),
-            [](G1Element32 src) { return G1Element(src); });
-        return elements;
+        auto remap = std::vector<uint32_t>(g1_expected_count::disc);
+        for (uint32_t i = 0; i < g1_expected_count::disc; i++)
+        {
+            if (i < 3549)
+            {
+                remap[i] = i;
+            }
+            else if (i < 3551)
+            {
+                // Extra two tutorial images
+                remap[i] = 3549;
+            }
+            else if (i < 3898)
+            {
+                remap[i] = i - 2;
+            }
+            else if (i < 3898 + 223)
+            {
+                // Extra font variant
+                remap[i] = 1788 + (i - 3898);
+            }
+            else
+            {
+                remap[i] = std::numeric_limits<uint32_t>::max();
+            }
+        }
+        return remap;
+    }
+
+    // Reads the whole file into memory, for when it can not be mapped
+    static std::unique_ptr<std::byte[]> readG1File(const fs::path& g1Path, size_t& size)
+    {
+        std::ifstream stream(g1Path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!stream)
+        {
+            throw std::runtime_error("Opening g1 file failed.");
+        }
+
+        size = static_cast<size_t>(stream.tellg());
+        stream.seekg(0);
+
+        auto data = std::make_unique<std::byte[]>(size);
+        if (!readData(stream, data.get(), size))
+        {
+            throw std::runtime_error("Reading g1 file failed.");
+        }
+        return data;
     }
 
     // 0x0044733C
     void loadG1()
     {
         auto g1Path = Environment::getPath(Environment::path_id::g1);
-        std::ifstream stream(g1Path, std::ios::in | std::ios::binary);
-        if (!stream)
+
+        // Element data is used in place, so the file is mapped rather than read where possible
+        const std::byte* g1Data = nullptr;
+        size_t g1Size = 0;
+        _g1Buffer.reset();
+        if (_g1File.map(g1Path))
         {
-            throw std::runtime_error("Opening g1 file failed.");
+            g1Data = _g1File.data();
+            g1Size = _g1File.size();
+        }
+        else
+        {
+            _g1Buffer = readG1File(g1Path, g1Size);
+            g1Data = _g1Buffer.get();
         }
 
         G1Header header;
-        if (!readData(stream, header))
+        if (g1Size < sizeof(header))
         {
             throw std::runtime_error("Reading g1 file header failed.");
         }
+        std::memcpy(&header, g1Data, sizeof(header));
 
         if (header.num_entries != g1_expected_count::disc)
         {
@@ -192,45 +249,40 @@ namespace OpenLoco::Gfx
             }
         }
 
-        // Read element headers
-        auto elements32 = std::vector<G1Element32>(header.num_entries);
-        if (!readData(stream, elements32.data(), header.num_entries))
+        const auto elementsOffset = sizeof(header);
+        const auto dataOffset = elementsOffset + static_cast<size_t>(header.num_entries) * sizeof(G1Element32);
+        if (header.num_entries > g1_expected_count::disc + g1_count_temporary || g1Size < dataOffset)
         {
             throw std::runtime_error("Reading g1 element headers failed.");
         }
-        auto elements = convertElements(elements32);
-
-        // Read element data
-        auto elementData = std::make_unique<std::byte[]>(header.total_size);
-        if (!readData(stream, elementData.get(), header.total_size))
+        if (g1Size - dataOffset < header.total_size)
         {
             throw std::runtime_error("Reading g1 elements failed.");
         }
-        stream.close();
 
-        // The steam G1.DAT is missing two localised tutorial icons, and a smaller font variant
-        // This code copies the closest variants into their place, and moves other elements accordingly
+        const auto* elements32 = reinterpret_cast<const G1Element32*>(g1Data + elementsOffset);
+        auto* elementData = const_cast<std::byte*>(g1Data + dataOffset);
+        auto toElement = [elementData](const G1Element32& src) {
+            auto element = G1Element(src);
+            element.offset = reinterpret_cast<uint8_t*>(elementData) + src.offset;
+            return element;
+        };
+
         if (header.num_entries == g1_expected_count::steam)
         {
-            elements.resize(g1_expected_count::disc);
-
-            // Extra two tutorial images
-            std::copy_n(&elements[3549], header.num_entries - 3549, &elements[3551]);
-            std::copy_n(&elements[3551], 1, &elements[3549]);
-            std::copy_n(&elements[3551], 1, &elements[3550]);
-
-            // Extra font variant
-            std::copy_n(&elements[1788], 223, &elements[3898]);
+            auto remap = getSteamElementRemap();
+            for (uint32_t i = 0; i < remap.size(); i++)
+            {
+                _g1Elements[i] = remap[i] < header.num_entries ? toElement(elements32[remap[i]]) : G1Element();
+            }
         }
-
-        // Adjust memory offsets
-        for (auto& element : elements)
+        else
         {
-            element.offset += (uintptr_t)elementData.get();
+            for (uint32_t i = 0; i < header.num_entries; i++)
+            {
+                _g1Elements[i] = toElement(elements32[i]);
+            }
         }
-
-        _g1Buffer = std::move(elementData);
-        std::copy(elements.begin(), elements.end(), _g1Elements.get());
     }
 
     // 0x00447485
@@ -274,85 +326,7 @@ namespace OpenLoco::Gfx
      */
     uint16_t getStringWidth(const char* buffer)
     {
-        uint16_t width = 0;
-        const uint8_t* str = reinterpret_cast<const uint8_t*>(buffer);
-        int16_t fontSpriteBase = _currentFontSpriteBase;
-
-        while (*str != (uint8_t)0)
-        {
-            const uint8_t chr = *str;
-            str++;
-
-            if (chr >= 32)
-            {
-                width += _characterWidths[chr - 32 + fontSpriteBase];
-                continue;
-            }
-
-            switch (chr)
-            {
-                case ControlCodes::move_x:
-                    width = *str;
-                    str++;
-                    break;
-
-                case ControlCodes::adjust_palette:
-                case 3:
-                case 4:
-                    str++;
-                    break;
-
-                case ControlCodes::newline:
-                case ControlCodes::newline_smaller:
-                    continue;
-
-                case ControlCodes::font_small:
-                    fontSpriteBase = Font::small;
-                    break;
-
-                case ControlCodes::font_large:
-                    fontSpriteBase = Font::large;
-                    break;
-
-                case ControlCodes::font_bold:
-                    fontSpriteBase = Font::medium_bold;
-                    break;
-
-                case ControlCodes::font_regular:
-                    fontSpriteBase = Font::medium_normal;
-                    break;
-
-                case ControlCodes::outline:
-                case ControlCodes::outline_off:
-                case ControlCodes::window_colour_1:
-                case ControlCodes::window_colour_2:
-                case ControlCodes::window_colour_3:
-                case ControlCodes::window_colour_4:
-                    break;
-
-                case ControlCodes::inline_sprite_str:
-                {
-                    const uint32_t image = reinterpret_cast<const uint32_t*>(str)[0];
-                    const uint32_t imageId = image & 0x7FFFF;
-                    str += 4;
-                    width += _g1Elements[imageId].width;
-                    break;
-                }
-
-                default:
-                    if (chr <= 0x16)
-                    {
-                        str += 2;
-                    }
-                    else
-                    {
-                        str += 4;
-                    }
-                    break;
-            }
-        }
-
-        return width;
+        return getTextLayout(buffer, _currentFontSpriteBase).width;
     }
 
     static void setTextColours(PaletteIndex_t pal1, PaletteIndex_t pal2, PaletteIndex_t pal3)
@@ -1007,21 +981,27 @@ namespace OpenLoco::Gfx
     // @return width @<cx>
     uint16_t getStringWidthNewLined(const char* buffer)
     {
-        registers regs;
-        regs.esi = (uintptr_t)buffer;
-        call(0x00495715, regs);
-        return regs.cx;
+        return getTextLayout(buffer, _currentFontSpriteBase).maxLineWidth;
     }
 
-    std::pair<uint16_t, uint16_t> wrapString(const char* buffer, uint16_t stringWidth)
+    /**
+     * 0x00495301
+     * Wraps the string in place, replacing spaces and newlines with null terminators.
+     *
+     * @param buffer @<esi>
+     * @param stringWidth @<di>
+     * @return maxWidth @<cx>, breakCount @<di>
+     */
+    std::pair<uint16_t, uint16_t> wrapString(char* buffer, uint16_t stringWidth)
     {
-        // gfx_wrap_string
-        registers regs;
-        regs.esi = (uintptr_t)buffer;
-        regs.di = stringWidth;
-        call(0x00495301, regs);
+        // Line breaks replace bytes in place, the text never grows past the caller's buffer
+        const auto& layout = getTextLayout(buffer, _currentFontSpriteBase, stringWidth);
+        for (auto offset : layout.breakOffsets)
+        {
+            buffer[offset] = '\0';
+        }
 
-        return std::make_pair(regs.cx, regs.di);
+        return std::make_pair(layout.maxLineWidth, layout.breakCount);
     }
 
     // 0x004474BA
@@ -1113,6 +1093,14 @@ namespace OpenLoco::Gfx
         engine->drawDirtyBlocks();
     }
 
+    Drawing::SoftwareDrawingEngine& getDrawingEngine()
+    {
+        if (engine == nullptr)
+            engine = new Drawing::SoftwareDrawingEngine();
+
+        return *engine;
+    }
+
     loco_global<char[512], 0x0112CC04> byte_112CC04;
     loco_global<char[512], 0x0112CE04> byte_112CE04;
 
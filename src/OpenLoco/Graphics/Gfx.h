@@ -12,6 +12,11 @@ namespace OpenLoco
     using Colour_t = uint8_t;
 }
 
+namespace OpenLoco::Drawing
+{
+    class SoftwareDrawingEngine;
+}
+
 namespace OpenLoco::Gfx
 {
 #pragma pack(push, 1)
@@ -218,7 +223,7 @@ namespace OpenLoco::Gfx
         uint8_t colour,
         const void* args);
     uint16_t getStringWidthNewLined(const char* buffer);
-    std::pair<uint16_t, uint16_t> wrapString(const char* buffer, uint16_t stringWidth);
+    std::pair<uint16_t, uint16_t> wrapString(char* buffer, uint16_t stringWidth);
 
     void fillRect(Gfx::Context* context, int16_t left, int16_t top, int16_t right, int16_t bottom, uint32_t colour);
     void drawRect(Gfx::Context* context, int16_t x, int16_t y, uint16_t dx, uint16_t dy, uint32_t colour);
@@ -238,6 +243,7 @@ namespace OpenLoco::Gfx
     void setDirtyBlocks(int32_t left, int32_t top, int32_t right, int32_t bottom);
     void drawDirtyBlocks();
     void render();
+    Drawing::SoftwareDrawingEngine& getDrawingEngine();
 
     void redrawScreenRect(Ui::Rect rect);
     void redrawScreenRect(int16_t left, int16_t top, int16_t right, int16_t bottom);
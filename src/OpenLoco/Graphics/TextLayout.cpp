@@ -0,0 +1,228 @@
+#include "TextLayout.h"
+#include "../Interop/Interop.hpp"
+#include "../Localisation/StringManager.h"
+#include "Gfx.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+using namespace OpenLoco::Interop;
+
+namespace OpenLoco::Gfx
+{
+    static loco_global<uint8_t[224 * 4], 0x112C884> _characterWidths;
+
+    static TextLayoutCache _textLayoutCache;
+
+    // Number of argument bytes following a control code
+    static size_t getControlCodeArgLength(uint8_t chr)
+    {
+        switch (chr)
+        {
+            case ControlCodes::move_x:
+            case ControlCodes::adjust_palette:
+            case 3:
+            case 4:
+                return 1;
+
+            case ControlCodes::inline_sprite_str:
+                return 4;
+
+            default:
+                if (chr < ControlCodes::newline_x_y)
+                {
+                    return 0;
+                }
+                return chr <= 0x16 ? 2 : 4;
+        }
+    }
+
+    // Length of a formatted string, which may contain null bytes within control code arguments
+    size_t getTextLength(const char* buffer)
+    {
+        const char* str = buffer;
+        while (*str != '\0')
+        {
+            const auto chr = static_cast<uint8_t>(*str);
+            str++;
+            if (chr < 32)
+            {
+                str += getControlCodeArgLength(chr);
+            }
+        }
+        return str - buffer;
+    }
+
+    /**
+     * Measures a formatted string and records the position of each glyph. If wrapWidth is non-zero,
+     * lines are broken at the last space that keeps them within wrapWidth. A word that does not fit on
+     * a line on its own is not split and overflows its line, so wrapping never changes the text length.
+     */
+    TextLayout layoutString(std::string_view text, int16_t fontSpriteBase, uint16_t wrapWidth)
+    {
+        TextLayout layout;
+        layout.text = text;
+        const auto& str = layout.text;
+
+        int16_t font = fontSpriteBase;
+        uint16_t width = 0;
+        uint16_t lineWidth = 0;
+        uint16_t line = 0;
+
+        // Last space on the current line, used as the break point when wrapping
+        size_t spaceOffset = std::string::npos;
+        size_t spaceGlyph = 0;
+        uint16_t spaceLineWidth = 0;
+        int16_t spaceFont = font;
+
+        auto endLine = [&](uint16_t finalWidth) {
+            layout.lineWidths.push_back(finalWidth);
+            layout.maxLineWidth = std::max(layout.maxLineWidth, finalWidth);
+            line++;
+            lineWidth = 0;
+            spaceOffset = std::string::npos;
+        };
+
+        size_t i = 0;
+        while (i < str.size())
+        {
+            const auto chr = static_cast<uint8_t>(str[i]);
+            if (chr >= 32 || chr == ControlCodes::inline_sprite_str)
+            {
+                uint16_t advance = 0;
+                size_t length = 1;
+                if (chr == ControlCodes::inline_sprite_str)
+                {
+                    uint32_t image = 0;
+                    std::memcpy(&image, &str[i + 1], std::min<size_t>(sizeof(image), str.size() - i - 1));
+                    auto* element = getG1Element(image & 0x7FFFF);
+                    if (element != nullptr)
+                    {
+                        advance = element->width;
+                    }
+                    length += sizeof(image);
+                }
+                else
+                {
+                    advance = _characterWidths[chr - 32 + font];
+                }
+
+                if (wrapWidth != 0 && lineWidth + advance > wrapWidth && spaceOffset != std::string::npos)
+                {
+                    // Replace the last space with a line break and lay out the rest of the line again
+                    layout.breakOffsets.push_back(static_cast<uint16_t>(spaceOffset));
+                    layout.glyphs.resize(spaceGlyph);
+                    font = spaceFont;
+                    i = spaceOffset + 1;
+                    endLine(spaceLineWidth);
+                    layout.breakCount++;
+                    continue;
+                }
+
+                if (chr == ' ')
+                {
+                    spaceOffset = i;
+                    spaceGlyph = layout.glyphs.size();
+                    spaceLineWidth = lineWidth;
+                    spaceFont = font;
+                }
+
+                layout.glyphs.push_back({ static_cast<uint16_t>(i), line, static_cast<int16_t>(lineWidth) });
+                lineWidth += advance;
+                width += advance;
+                i += length;
+                continue;
+            }
+
+            switch (chr)
+            {
+                case ControlCodes::move_x:
+                    lineWidth = static_cast<uint8_t>(str[i + 1]);
+                    width = lineWidth;
+                    break;
+
+                case ControlCodes::newline:
+                    if (wrapWidth != 0)
+                    {
+                        layout.breakOffsets.push_back(static_cast<uint16_t>(i));
+                        layout.breakCount++;
+                    }
+                    endLine(lineWidth);
+                    break;
+
+                case ControlCodes::newline_smaller:
+                    endLine(lineWidth);
+                    break;
+
+                case ControlCodes::font_small:
+                    font = Font::small;
+                    break;
+
+                case ControlCodes::font_large:
+                    font = Font::large;
+                    break;
+
+                case ControlCodes::font_bold:
+                    font = Font::medium_bold;
+                    break;
+
+                case ControlCodes::font_regular:
+                    font = Font::medium_normal;
+                    break;
+            }
+            i += 1 + getControlCodeArgLength(chr);
+        }
+
+        layout.lineWidths.push_back(lineWidth);
+        layout.maxLineWidth = std::max(layout.maxLineWidth, lineWidth);
+        layout.width = wrapWidth != 0 ? layout.maxLineWidth : width;
+        return layout;
+    }
+
+    size_t TextLayoutCache::KeyHash::operator()(const Key& key) const
+    {
+        auto hash = std::hash<std::string_view>()(key.text);
+        auto params = (static_cast<size_t>(static_cast<uint16_t>(key.fontSpriteBase)) << 16) | key.wrapWidth;
+        return hash ^ (params + 0x9E3779B9 + (hash << 6) + (hash >> 2));
+    }
+
+    // The returned reference is only valid until the next call as the entry may be evicted
+    const TextLayout& TextLayoutCache::get(std::string_view text, int16_t fontSpriteBase, uint16_t wrapWidth)
+    {
+        auto it = _lookup.find(Key{ text, fontSpriteBase, wrapWidth });
+        if (it != _lookup.end())
+        {
+            _entries.splice(_entries.begin(), _entries, it->second);
+            return it->second->layout;
+        }
+
+        if (_entries.size() >= maxEntries)
+        {
+            const auto& last = _entries.back();
+            _lookup.erase(Key{ last.text, last.fontSpriteBase, last.wrapWidth });
+            _entries.pop_back();
+        }
+
+        _entries.push_front(Entry{ std::string(text), fontSpriteBase, wrapWidth, layoutString(text, fontSpriteBase, wrapWidth) });
+        auto& entry = _entries.front();
+        _lookup.emplace(Key{ entry.text, entry.fontSpriteBase, entry.wrapWidth }, _entries.begin());
+        return entry.layout;
+    }
+
+    void TextLayoutCache::clear()
+    {
+        _lookup.clear();
+        _entries.clear();
+    }
+
+    const TextLayout& getTextLayout(const char* buffer, int16_t fontSpriteBase, uint16_t wrapWidth)
+    {
+        return _textLayoutCache.get(std::string_view(buffer, getTextLength(buffer)), fontSpriteBase, wrapWidth);
+    }
+
+    // Must be called whenever character widths or sprite sizes change
+    void invalidateTextLayoutCache()
+    {
+        _textLayoutCache.clear();
+    }
+}
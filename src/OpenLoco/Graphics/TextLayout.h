@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace OpenLoco::Gfx
+{
+    struct GlyphPosition
+    {
+        uint16_t offset; // Byte offset of the glyph in TextLayout::text
+        uint16_t line;
+        int16_t x;
+    };
+
+    struct TextLayout
+    {
+        uint16_t width = 0;        // Width as measured by getStringWidth, or the widest line when wrapped
+        uint16_t maxLineWidth = 0; // Width of the widest line
+        uint16_t breakCount = 0;   // Number of line breaks made by wrapping
+        std::vector<uint16_t> lineWidths;
+        std::vector<GlyphPosition> glyphs;
+        std::vector<uint16_t> breakOffsets; // Bytes of text that wrapping replaces with '\0'
+        std::string text;                   // Laid out text as given, breakOffsets are not applied
+    };
+
+    /**
+     * Least recently used cache of measured and wrapped strings, keyed on the
+     * formatted string bytes, the starting font and the wrap width.
+     */
+    class TextLayoutCache
+    {
+    public:
+        static constexpr size_t maxEntries = 4096;
+
+        const TextLayout& get(std::string_view text, int16_t fontSpriteBase, uint16_t wrapWidth);
+        void clear();
+
+        size_t size() const { return _entries.size(); }
+
+    private:
+        struct Key
+        {
+            std::string_view text;
+            int16_t fontSpriteBase;
+            uint16_t wrapWidth;
+
+            bool operator==(const Key& rhs) const
+            {
+                return fontSpriteBase == rhs.fontSpriteBase && wrapWidth == rhs.wrapWidth && text == rhs.text;
+            }
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const;
+        };
+
+        struct Entry
+        {
+            std::string text;
+            int16_t fontSpriteBase;
+            uint16_t wrapWidth;
+            TextLayout layout;
+        };
+
+        // Most recently used entries are kept at the front
+        std::list<Entry> _entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _lookup;
+    };
+
+    size_t getTextLength(const char* buffer);
+    TextLayout layoutString(std::string_view text, int16_t fontSpriteBase, uint16_t wrapWidth);
+    const TextLayout& getTextLayout(const char* buffer, int16_t fontSpriteBase, uint16_t wrapWidth = 0);
+    void invalidateTextLayoutCache();
+}
@@ -352,6 +352,9 @@ namespace OpenLoco::Input
                 continue;
             }
 
+            if (Ui::Windows::ObjectSelectionWindow::handleInput(nextKey->charCode, nextKey->keyCode))
+                continue;
+
             if (Tutorial::state() == Tutorial::State::playing)
             {
                 Tutorial::stop();
@@ -493,9 +496,7 @@ namespace OpenLoco::Input
             {
                 try
                 {
-                    std::string fileName = saveScreenshot();
-                    *((const char**)(&_commonFormatArgs[0])) = fileName.c_str();
-                    Windows::showError(StringIds::screenshot_saved_as, StringIds::null, false);
+                    saveScreenshot();
                 }
                 catch (const std::exception&)
                 {
@@ -504,6 +505,19 @@ namespace OpenLoco::Input
             }
         }
 
+        for (const auto& result : takeFinishedScreenshots())
+        {
+            if (result.success)
+            {
+                *((const char**)(&_commonFormatArgs[0])) = result.fileName.c_str();
+                Windows::showError(StringIds::screenshot_saved_as, StringIds::null, false);
+            }
+            else
+            {
+                Windows::showError(StringIds::screenshot_failed);
+            }
+        }
+
         edgeScroll();
 
         _keyModifier = _keyModifier & ~(KeyModifier::shift | KeyModifier::control | KeyModifier::unknown);
@@ -23,6 +23,16 @@ namespace OpenLoco::Interop
     static registers _hookRegisters;
     static uintptr_t _lastHook;
 
+    struct ProfiledHook
+    {
+        uintptr_t address;
+        hook_function function;
+    };
+
+    // Hooks registered while profiling is enabled are routed through profiledHook
+    static std::vector<ProfiledHook> _profiledHooks;
+    static int32_t _profiledHookIndex;
+
 // This macro writes a little-endian 4-byte long value into *data
 // It is used to avoid type punning.
 #define WRITE_ADDRESS_STRICTALIAS(data, addr) \
@@ -31,13 +41,32 @@ namespace OpenLoco::Interop
     *(data + 2) = ((addr)&0x00ff0000) >> 16;  \
     *(data + 3) = ((addr)&0xff000000) >> 24;
 
-    static bool hookFunc(uintptr_t address, uintptr_t hookAddress, int32_t stacksize)
+    static uint8_t FORCE_ALIGN_ARG_POINTER profiledHook(registers& regs)
+    {
+        const auto hook = _profiledHooks[_profiledHookIndex];
+        profileEnter(static_cast<uint32_t>(hook.address), true);
+        auto result = hook.function(regs);
+        profileLeave();
+        return result;
+    }
+
+    static bool hookFunc(uintptr_t address, uintptr_t hookAddress, int32_t stacksize, int32_t profiledHookIndex)
     {
         int32_t i = 0;
         uint8_t data[HOOK_BYTE_COUNT] = { 0 };
 
         uintptr_t registerAddress = (uintptr_t)&_hookRegisters;
 
+        if (profiledHookIndex != -1)
+        {
+            data[i++] = 0xC7; // mov [_profiledHookIndex], profiledHookIndex
+            data[i++] = 0x05;
+            WRITE_ADDRESS_STRICTALIAS(&data[i], (uintptr_t)&_profiledHookIndex);
+            i += 4;
+            WRITE_ADDRESS_STRICTALIAS(&data[i], profiledHookIndex);
+            i += 4;
+        }
+
         data[i++] = 0x89; // mov [_hookRegisters], eax
         data[i++] = (0b000 << 3) | 0b101;
         WRITE_ADDRESS_STRICTALIAS(&data[i], registerAddress);
@@ -186,6 +215,11 @@ namespace OpenLoco::Interop
             Console::error("Failed registering hook for 0x%08x. Ran out of hook table space", address);
             return;
         }
+        if (isProfilingEnabled())
+        {
+            _profiledHooks.push_back({ address, function });
+        }
+
         // Do a few retries here. This can fail on some versions of wine which inexplicably would fail on
         // WriteProcessMemory for specific addresses that we fully own, but skipping over failing entry would work.
         bool done = false;
@@ -204,7 +238,14 @@ namespace OpenLoco::Interop
 
             writeMemory(address, data, i);
 
-            done = hookFunc(hookaddress, (uintptr_t)function, 0);
+            if (isProfilingEnabled())
+            {
+                done = hookFunc(hookaddress, (uintptr_t)&profiledHook, 0, static_cast<int32_t>(_profiledHooks.size() - 1));
+            }
+            else
+            {
+                done = hookFunc(hookaddress, (uintptr_t)function, 0, -1);
+            }
             _hookTableOffset++;
             retries--;
             if (!done)
@@ -22,6 +22,7 @@
 #include "../Platform/Platform.h"
 #include "../S5/S5.h"
 #include "../Scenario.h"
+#include "../ScenarioManager.h"
 #include "../Station.h"
 #include "../StationManager.h"
 #include "../Title.h"
@@ -37,7 +38,7 @@
 
 using namespace OpenLoco;
 
-#define STUB() Console::logVerbose(__FUNCTION__)
+#define STUB() Console::logVerbose(Console::Category::interop, __FUNCTION__)
 
 #ifdef _MSC_VER
 #define STDCALL __stdcall
@@ -187,7 +188,7 @@ static void CDECL fn_4081ad(int32_t wParam)
 FORCE_ALIGN_ARG_POINTER
 static uint32_t CDECL fn_FileSeekSet(FILE* a0, int32_t distance)
 {
-    Console::logVerbose("seek %d bytes from start", distance);
+    Console::logVerbose(Console::Category::interop, "seek %d bytes from start", distance);
     fseek(a0, distance, SEEK_SET);
     return ftell(a0);
 }
@@ -195,7 +196,7 @@ static uint32_t CDECL fn_FileSeekSet(FILE* a0, int32_t distance)
 FORCE_ALIGN_ARG_POINTER
 static uint32_t CDECL fn_FileSeekFromCurrent(FILE* a0, int32_t distance)
 {
-    Console::logVerbose("seek %d bytes from current", distance);
+    Console::logVerbose(Console::Category::interop, "seek %d bytes from current", distance);
     fseek(a0, distance, SEEK_CUR);
     return ftell(a0);
 }
@@ -203,7 +204,7 @@ static uint32_t CDECL fn_FileSeekFromCurrent(FILE* a0, int32_t distance)
 FORCE_ALIGN_ARG_POINTER
 static uint32_t CDECL fn_FileSeekFromEnd(FILE* a0, int32_t distance)
 {
-    Console::logVerbose("seek %d bytes from end", distance);
+    Console::logVerbose(Console::Category::interop, "seek %d bytes from end", distance);
     fseek(a0, distance, SEEK_END);
     return ftell(a0);
 }
@@ -211,7 +212,7 @@ static uint32_t CDECL fn_FileSeekFromEnd(FILE* a0, int32_t distance)
 FORCE_ALIGN_ARG_POINTER
 static int32_t CDECL fn_FileRead(FILE* a0, char* buffer, int32_t size)
 {
-    Console::logVerbose("read %d bytes (%d)", size, fileno(a0));
+    Console::logVerbose(Console::Category::interop, "read %d bytes (%d)", size, fileno(a0));
     size = fread(buffer, 1, size, a0);
 
     return size;
@@ -242,7 +243,7 @@ public:
 FORCE_ALIGN_ARG_POINTER
 static Session* CDECL fn_FindFirstFile(char* lpFileName, FindFileData* out)
 {
-    Console::logVerbose("%s (%s)", __FUNCTION__, lpFileName);
+    Console::logVerbose(Console::Category::interop, "%s (%s)", __FUNCTION__, lpFileName);
 
     Session* data = new Session;
 
@@ -406,7 +407,7 @@ static bool STDCALL lib_WriteFile(
     uintptr_t lpOverlapped)
 {
     *lpNumberOfBytesWritten = fwrite(buffer, 1, nNumberOfBytesToWrite, hFile);
-    Console::logVerbose("WriteFile(%s)", buffer);
+    Console::logVerbose(Console::Category::interop, "WriteFile(%s)", buffer);
 
     return true;
 }
@@ -430,7 +431,7 @@ static int32_t STDCALL lib_CreateFileA(
     uint32_t dwFlagsAndAttributes,
     uintptr_t hTemplateFile)
 {
-    Console::logVerbose("CreateFile(%s, 0x%x, 0x%x)", lpFileName, dwDesiredAccess, dwCreationDisposition);
+    Console::logVerbose(Console::Category::interop, "CreateFile(%s, 0x%x, 0x%x)", lpFileName, dwDesiredAccess, dwCreationDisposition);
 
     FILE* pFILE = nullptr;
     if (dwDesiredAccess == GENERIC_READ && dwCreationDisposition == OPEN_EXISTING)
@@ -781,6 +782,7 @@ void OpenLoco::Interop::registerHooks()
     Ui::ViewportManager::registerHooks();
     GameCommands::registerHooks();
     Scenario::registerHooks();
+    ScenarioManager::registerHooks();
     StationManager::registerHooks();
     S5::registerHooks();
     Title::registerHooks();
@@ -901,6 +903,19 @@ void OpenLoco::Interop::registerHooks()
     // vehicles that are using it.
     writeNop(0x004776DD, 6);
 
+    // Misc entities created by the original game also leave numEntitiesReservedForVehicles free
+    registerHook(
+        0x004700A5,
+        [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+            registers backup = regs;
+
+            auto* entity = EntityManager::createEntityMisc();
+
+            regs = backup;
+            regs.esi = reinterpret_cast<uint32_t>(entity);
+            return entity == nullptr ? X86_FLAG_ZERO : 0;
+        });
+
     registerHook(
         0x0047024A,
         [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
@@ -1,7 +1,12 @@
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
 #include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
 #include <stdexcept>
+#include <string>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -280,8 +285,205 @@ namespace OpenLoco::Interop
         return call(address, regs);
     }
 
+    using ProfileClock = std::chrono::high_resolution_clock;
+
+    // A unique call path, the root node has no address
+    struct ProfileNode
+    {
+        uint32_t address = 0;
+        bool isHook = false;
+        ProfileNode* parent = nullptr;
+        std::map<std::pair<uint32_t, bool>, std::unique_ptr<ProfileNode>> children;
+        ProfileClock::duration selfTime{};
+    };
+
+    struct ProfileStats
+    {
+        uint64_t calls = 0;
+        uint32_t activeCalls = 0; // Recursive calls are only timed by the outermost call
+        uint32_t maxDepth = 0;
+        ProfileClock::duration inclusiveTime{};
+        ProfileClock::duration selfTime{};
+    };
+
+    struct ProfileFrame
+    {
+        ProfileNode* node;
+        ProfileStats* stats;
+        ProfileClock::time_point start;
+        ProfileClock::duration childTime;
+    };
+
+    static bool _profilingEnabled = false;
+    static ProfileNode _profileRoot;
+    static std::map<std::pair<uint32_t, bool>, ProfileStats> _profileStats;
+    static std::vector<ProfileFrame> _profileStack;
+
+    void setProfilingEnabled(bool enabled)
+    {
+        _profilingEnabled = enabled;
+    }
+
+    bool isProfilingEnabled()
+    {
+        return _profilingEnabled;
+    }
+
+    // Interop calls are only made from the main thread so no locking is done here
+    void profileEnter(uint32_t address, bool isHook)
+    {
+        auto* parent = _profileStack.empty() ? &_profileRoot : _profileStack.back().node;
+        auto& child = parent->children[{ address, isHook }];
+        if (child == nullptr)
+        {
+            child = std::make_unique<ProfileNode>();
+            child->address = address;
+            child->isHook = isHook;
+            child->parent = parent;
+        }
+
+        auto& stats = _profileStats[{ address, isHook }];
+        stats.calls++;
+        stats.activeCalls++;
+        stats.maxDepth = std::max<uint32_t>(stats.maxDepth, static_cast<uint32_t>(_profileStack.size() + 1));
+
+        _profileStack.push_back({ child.get(), &stats, ProfileClock::now(), {} });
+    }
+
+    void profileLeave()
+    {
+        if (_profileStack.empty())
+        {
+            return;
+        }
+
+        auto frame = _profileStack.back();
+        _profileStack.pop_back();
+
+        const auto elapsed = ProfileClock::now() - frame.start;
+        const auto selfTime = elapsed - frame.childTime;
+        frame.node->selfTime += selfTime;
+        frame.stats->selfTime += selfTime;
+        frame.stats->activeCalls--;
+        if (frame.stats->activeCalls == 0)
+        {
+            frame.stats->inclusiveTime += elapsed;
+        }
+
+        if (!_profileStack.empty())
+        {
+            _profileStack.back().childTime += elapsed;
+        }
+    }
+
+    size_t getProfileDepth()
+    {
+        return _profileStack.size();
+    }
+
+    // Closes frames that were skipped by a long jump out of original code
+    void unwindProfile(size_t depth)
+    {
+        while (_profileStack.size() > depth)
+        {
+            profileLeave();
+        }
+    }
+
+    void resetProfile()
+    {
+        _profileStack.clear();
+        _profileStats.clear();
+        _profileRoot.children.clear();
+    }
+
+    static std::string getProfileFrameName(uint32_t address, bool isHook)
+    {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), isHook ? "hook_0x%08X" : "0x%08X", address);
+        return buffer;
+    }
+
+    static void writeFoldedStacks(std::ostream& stream, const ProfileNode& node, const std::string& path)
+    {
+        for (const auto& [key, child] : node.children)
+        {
+            auto childPath = path.empty() ? getProfileFrameName(child->address, child->isHook) : path + ";" + getProfileFrameName(child->address, child->isHook);
+            const auto selfTime = std::chrono::duration_cast<std::chrono::microseconds>(child->selfTime).count();
+            if (selfTime > 0)
+            {
+                stream << childPath << " " << selfTime << "\n";
+            }
+            writeFoldedStacks(stream, *child, childPath);
+        }
+    }
+
+    /**
+     * Writes a report of every profiled address sorted by inclusive time, and a folded stack file
+     * with one line per call path weighted by self time in microseconds, for use with flamegraph.pl.
+     */
+    void writeProfile(const char* reportPath, const char* foldedPath)
+    {
+        std::vector<std::pair<std::pair<uint32_t, bool>, ProfileStats>> entries(_profileStats.begin(), _profileStats.end());
+        std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.inclusiveTime > rhs.second.inclusiveTime;
+        });
+
+        std::ofstream report(reportPath);
+        if (!report.is_open())
+        {
+            Console::error("Unable to write interop profile to '%s'", reportPath);
+            return;
+        }
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-20s %12s %14s %14s %12s %9s\n", "address", "calls", "inclusive ms", "self ms", "avg us", "max depth");
+        report << line;
+        for (const auto& [key, stats] : entries)
+        {
+            const auto inclusive = std::chrono::duration<double, std::milli>(stats.inclusiveTime).count();
+            const auto self = std::chrono::duration<double, std::milli>(stats.selfTime).count();
+            const auto average = stats.calls != 0 ? inclusive * 1000.0 / stats.calls : 0.0;
+            std::snprintf(
+                line,
+                sizeof(line),
+                "%-20s %12" PRIu64 " %14.3f %14.3f %12.3f %9" PRIu32 "\n",
+                getProfileFrameName(key.first, key.second).c_str(),
+                stats.calls,
+                inclusive,
+                self,
+                average,
+                stats.maxDepth);
+            report << line;
+        }
+
+        std::ofstream folded(foldedPath);
+        if (!folded.is_open())
+        {
+            Console::error("Unable to write interop profile to '%s'", foldedPath);
+            return;
+        }
+        writeFoldedStacks(folded, _profileRoot, "");
+    }
+
     int32_t call(int32_t address, registers& registers)
     {
+        if (_profilingEnabled)
+        {
+            profileEnter(address, false);
+            auto result = callByRef(
+                address,
+                &registers.eax,
+                &registers.ebx,
+                &registers.ecx,
+                &registers.edx,
+                &registers.esi,
+                &registers.edi,
+                &registers.ebp);
+            profileLeave();
+            return result;
+        }
+
         return callByRef(
             address,
             &registers.eax,
@@ -122,6 +122,17 @@ namespace OpenLoco::Interop
     int32_t call(int32_t address);
     int32_t call(int32_t address, registers& registers);
 
+    // Records call counts, inclusive and self time and nesting of every call() target and hook.
+    // Must be enabled before hooks are registered for them to be included.
+    void setProfilingEnabled(bool enabled);
+    bool isProfilingEnabled();
+    void profileEnter(uint32_t address, bool isHook);
+    void profileLeave();
+    size_t getProfileDepth();
+    void unwindProfile(size_t depth);
+    void resetProfile();
+    void writeProfile(const char* reportPath, const char* foldedPath);
+
     template<typename T, uintptr_t TAddress>
     struct loco_global
     {
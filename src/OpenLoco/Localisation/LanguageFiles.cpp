@@ -10,7 +10,11 @@
 #include "StringManager.h"
 #include "Unicode.h"
 #include <cassert>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <random>
 #include <stdexcept>
 
 using namespace OpenLoco::Interop;
@@ -19,6 +23,8 @@ namespace OpenLoco::Localisation
 {
     static loco_global<char* [0xFFFF], 0x005183FC> _strings;
     static std::vector<std::unique_ptr<char[]>> _strings_owner;
+    static std::vector<std::unique_ptr<platform::MappedFile>> _mappedPacks;
+    static std::vector<bool> _languageStrings;
 
     static std::map<std::string, uint8_t, std::less<>> basicCommands = {
         { "INT16_1DP", ControlCodes::int16_decimals },
@@ -52,7 +58,8 @@ namespace OpenLoco::Localisation
         { "GREEN", ControlCodes::colour_green },
     };
 
-    static std::unique_ptr<char[]> readString(const char* value, size_t size)
+    // Converts a UTF-8 string to Loco encoding. Length includes the terminating NULL character.
+    static std::unique_ptr<char[]> readString(const char* value, size_t size, size_t& length)
     {
         // Take terminating NULL character in account
         auto str = std::make_unique<char[]>(size + 1);
@@ -221,6 +228,7 @@ namespace OpenLoco::Localisation
                 break;
         }
 
+        length = out - str.get();
         return str;
     }
 
@@ -230,29 +238,179 @@ namespace OpenLoco::Localisation
             || id == StringIds::buffer_2039 || id == StringIds::buffer_2040 || id == StringIds::buffer_2042 || id == StringIds::buffer_2045;
     }
 
-    static bool loadLanguageStringTable(fs::path languageFile)
+    // A language pack holds every converted string of a language file in one blob with an offset table, so later
+    // launches can skip parsing the YAML. A pack is only used while the language file it was built from is unchanged.
+    constexpr uint32_t languagePackMagic = 0x504C4C4F; // OLLP
+    constexpr uint32_t languagePackVersion = 1;
+
+#pragma pack(push, 1)
+    struct LanguagePackHeader
     {
-        try
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;
+        uint32_t numStrings;
+        uint32_t blobSize;
+    };
+
+    struct LanguagePackEntry
+    {
+        uint32_t id;
+        uint32_t offset;
+    };
+#pragma pack(pop)
+
+    static size_t getLanguagePackSize(const LanguagePackHeader& header)
+    {
+        return sizeof(LanguagePackHeader) + header.numStrings * sizeof(LanguagePackEntry) + header.blobSize;
+    }
+
+    // FNV-1a
+    static uint64_t hashLanguageFile(const std::string& data)
+    {
+        uint64_t hash = 0xCBF29CE484222325;
+        for (auto ch : data)
+        {
+            hash ^= static_cast<uint8_t>(ch);
+            hash *= 0x100000001B3;
+        }
+        return hash;
+    }
+
+    static fs::path getLanguagePackPath(const fs::path& languageFile)
+    {
+        auto cacheDirectory = Environment::getPathNoWarning(Environment::path_id::openloco_yml).parent_path() / "language_cache";
+        return cacheDirectory / languageFile.filename().replace_extension(".bin");
+    }
+
+    static bool isValidLanguagePack(const std::byte* pack, size_t size, uint64_t sourceHash)
+    {
+        if (size < sizeof(LanguagePackHeader))
         {
-            YAML::Node node = YAML::LoadFile(languageFile.string());
-            node = node["strings"];
+            return false;
+        }
+
+        const auto& header = *reinterpret_cast<const LanguagePackHeader*>(pack);
+        if (header.magic != languagePackMagic || header.version != languagePackVersion || header.sourceHash != sourceHash || getLanguagePackSize(header) != size)
+        {
+            return false;
+        }
 
-            for (YAML::const_iterator it = node.begin(); it != node.end(); ++it)
+        const auto* entries = reinterpret_cast<const LanguagePackEntry*>(pack + sizeof(LanguagePackHeader));
+        const auto* blob = reinterpret_cast<const char*>(entries + header.numStrings);
+        for (uint32_t i = 0; i < header.numStrings; i++)
+        {
+            if (entries[i].id >= 0xFFFF || entries[i].offset >= header.blobSize)
             {
-                int id = it->first.as<int>();
-                if (stringIsBuffer(id))
-                    continue;
+                return false;
+            }
+        }
+        return header.blobSize == 0 || blob[header.blobSize - 1] == '\0';
+    }
+
+    static std::unique_ptr<char[]> buildLanguagePack(const YAML::Node& strings, uint64_t sourceHash)
+    {
+        std::vector<LanguagePackEntry> entries;
+        std::vector<char> blob;
+        for (YAML::const_iterator it = strings.begin(); it != strings.end(); ++it)
+        {
+            int id = it->first.as<int>();
+            if (stringIsBuffer(id))
+                continue;
 
-                std::string new_string = it->second.as<std::string>();
-                _strings_owner.emplace_back(readString(new_string.data(), new_string.length()));
-                char* processed_string = _strings_owner.back().get();
+            std::string new_string = it->second.as<std::string>();
+            size_t length;
+            auto processed_string = readString(new_string.data(), new_string.length(), length);
 
-                if (processed_string != nullptr)
+            entries.push_back({ static_cast<uint32_t>(id), static_cast<uint32_t>(blob.size()) });
+            blob.insert(blob.end(), processed_string.get(), processed_string.get() + length);
+        }
+
+        LanguagePackHeader header{};
+        header.magic = languagePackMagic;
+        header.version = languagePackVersion;
+        header.sourceHash = sourceHash;
+        header.numStrings = static_cast<uint32_t>(entries.size());
+        header.blobSize = static_cast<uint32_t>(blob.size());
+
+        auto pack = std::make_unique<char[]>(getLanguagePackSize(header));
+        auto* out = pack.get();
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        std::memcpy(out, entries.data(), entries.size() * sizeof(LanguagePackEntry));
+        out += entries.size() * sizeof(LanguagePackEntry);
+        std::memcpy(out, blob.data(), blob.size());
+        return pack;
+    }
+
+    // The pack is written next to the old one and renamed over it, another instance may have the old one mapped
+    static void writeLanguagePack(const fs::path& path, const char* pack)
+    {
+        const auto& header = *reinterpret_cast<const LanguagePackHeader*>(pack);
+        auto tempPath = path;
+        tempPath += ".tmp" + std::to_string(std::random_device()());
+        try
+        {
+            Environment::autoCreateDirectory(path.parent_path());
+            {
+                std::ofstream stream(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+                stream.write(pack, getLanguagePackSize(header));
+                if (!stream)
                 {
-                    _strings[id] = processed_string;
+                    throw std::runtime_error("Unable to write " + tempPath.u8string());
                 }
             }
+            fs::rename(tempPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Console::error("Unable to write language pack: %s", e.what());
+            std::error_code ec;
+            fs::remove(tempPath, ec);
+        }
+    }
 
+    // Points the string table into the pack, which must stay loaded until the language is unloaded
+    static void applyLanguagePack(char* pack)
+    {
+        const auto& header = *reinterpret_cast<const LanguagePackHeader*>(pack);
+        const auto* entries = reinterpret_cast<const LanguagePackEntry*>(pack + sizeof(LanguagePackHeader));
+        auto* blob = pack + sizeof(LanguagePackHeader) + header.numStrings * sizeof(LanguagePackEntry);
+        for (uint32_t i = 0; i < header.numStrings; i++)
+        {
+            _strings[entries[i].id] = blob + entries[i].offset;
+            _languageStrings[entries[i].id] = true;
+        }
+    }
+
+    static bool loadLanguageStringTable(fs::path languageFile)
+    {
+        try
+        {
+            std::ifstream stream(languageFile, std::ios::in | std::ios::binary);
+            if (!stream.is_open())
+            {
+                std::cerr << "Unable to open " << languageFile.u8string() << "\n";
+                return false;
+            }
+            const std::string source((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+            const auto sourceHash = hashLanguageFile(source);
+            const auto packPath = getLanguagePackPath(languageFile);
+            auto mappedPack = std::make_unique<platform::MappedFile>();
+            if (mappedPack->map(packPath) && isValidLanguagePack(mappedPack->data(), mappedPack->size(), sourceHash))
+            {
+                applyLanguagePack(reinterpret_cast<char*>(mappedPack->data()));
+                _mappedPacks.emplace_back(std::move(mappedPack));
+                return true;
+            }
+            mappedPack->unmap();
+
+            YAML::Node node = YAML::Load(source);
+            auto pack = buildLanguagePack(node["strings"], sourceHash);
+            writeLanguagePack(packPath, pack.get());
+            applyLanguagePack(pack.get());
+            _strings_owner.emplace_back(std::move(pack));
             return true;
         }
         catch (const std::exception& e)
@@ -264,6 +422,9 @@ namespace OpenLoco::Localisation
 
     void loadLanguageFile()
     {
+        _languageStrings.assign(0x10000, false);
+        StringManager::invalidateCompiledStrings();
+
         // First, load en-GB for fallback strings.
         fs::path languageDir = Environment::getPath(Environment::path_id::language_files);
         fs::path languageFile = languageDir / "en-GB.yml";
@@ -284,5 +445,14 @@ namespace OpenLoco::Localisation
     void unloadLanguageFile()
     {
         _strings_owner.clear();
+        _mappedPacks.clear();
+        _languageStrings.clear();
+        StringManager::invalidateCompiledStrings();
+    }
+
+    // Whether the string was loaded from a language file and stays unchanged until the language is unloaded
+    bool isLanguageString(string_id id)
+    {
+        return id < _languageStrings.size() && _languageStrings[id];
     }
 }
@@ -1,7 +1,9 @@
+#include "../Types.hpp"
 #include <cstdint>
 
 namespace OpenLoco::Localisation
 {
     void loadLanguageFile();
     void unloadLanguageFile();
+    bool isLanguageString(string_id id);
 }
@@ -60,6 +60,7 @@ namespace OpenLoco::StringIds
     constexpr string_id month_short_november = 51;
     constexpr string_id month_short_december = 52;
 
+    constexpr string_id unable_to_allocate_enough_memory = 55;
     constexpr string_id close_window_cross = 56;
     constexpr string_id chosen_name_in_use = 57;
     constexpr string_id too_many_names_in_use = 58;
@@ -111,6 +112,7 @@ namespace OpenLoco::StringIds
     constexpr string_id menu_screenshot = 108;
     constexpr string_id screenshot_saved_as = 109;
     constexpr string_id screenshot_failed = 110;
+    constexpr string_id landscape_data_area_full = 111;
 
     constexpr string_id stringid_2 = 113;
     constexpr string_id tooltip_left_hand_curve = 114;
@@ -1662,4 +1664,14 @@ namespace OpenLoco::StringIds
     constexpr string_id no_cargo_selected = 2215;
     constexpr string_id tooltip_open_station_window_to_filter = 2216;
     constexpr string_id tooltip_select_cargo_type = 2217;
+    constexpr string_id object_selection_search = 2218;
+    constexpr string_id menu_giant_screenshot = 2219;
+    constexpr string_id landscape_seed = 2220;
+    constexpr string_id landscape_seed_value = 2221;
+    constexpr string_id landscape_seed_random = 2222;
+    constexpr string_id landscape_seed_random_last = 2223;
+    constexpr string_id landscape_seed_raw = 2224;
+    constexpr string_id title_landscape_seed = 2225;
+    constexpr string_id prompt_enter_landscape_seed = 2226;
+    constexpr string_id tooltip_landscape_seed = 2227;
 }
@@ -7,13 +7,16 @@
 #include "../Objects/ObjectManager.h"
 #include "../TownManager.h"
 #include "ArgsWrapper.hpp"
+#include "LanguageFiles.h"
 #include "StringIds.h"
 
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstring>
-#include <map>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 using namespace OpenLoco::Interop;
 
@@ -31,55 +34,78 @@ namespace OpenLoco::StringManager
     static loco_global<char* [0xFFFF], 0x005183FC> _strings;
     static loco_global<char[NUM_USER_STRINGS][USER_STRING_SIZE], 0x0095885C> _userStrings;
 
-    static std::map<int32_t, string_id> day_to_string = {
-        { 1, StringIds::day_1st },
-        { 2, StringIds::day_2nd },
-        { 3, StringIds::day_3rd },
-        { 4, StringIds::day_4th },
-        { 5, StringIds::day_5th },
-        { 6, StringIds::day_6th },
-        { 7, StringIds::day_7th },
-        { 8, StringIds::day_8th },
-        { 9, StringIds::day_9th },
-        { 10, StringIds::day_10th },
-        { 11, StringIds::day_11th },
-        { 12, StringIds::day_12th },
-        { 13, StringIds::day_13th },
-        { 14, StringIds::day_14th },
-        { 15, StringIds::day_15th },
-        { 16, StringIds::day_16th },
-        { 17, StringIds::day_17th },
-        { 18, StringIds::day_18th },
-        { 19, StringIds::day_19th },
-        { 20, StringIds::day_20th },
-        { 21, StringIds::day_21st },
-        { 22, StringIds::day_22nd },
-        { 23, StringIds::day_23rd },
-        { 24, StringIds::day_24th },
-        { 25, StringIds::day_25th },
-        { 26, StringIds::day_26th },
-        { 27, StringIds::day_27th },
-        { 28, StringIds::day_28th },
-        { 29, StringIds::day_29th },
-        { 30, StringIds::day_30th },
-        { 31, StringIds::day_31st },
+    // Indexed by day of the month, starting from 1
+    static constexpr std::array<string_id, 32> dayToString = {
+        0,
+        StringIds::day_1st,
+        StringIds::day_2nd,
+        StringIds::day_3rd,
+        StringIds::day_4th,
+        StringIds::day_5th,
+        StringIds::day_6th,
+        StringIds::day_7th,
+        StringIds::day_8th,
+        StringIds::day_9th,
+        StringIds::day_10th,
+        StringIds::day_11th,
+        StringIds::day_12th,
+        StringIds::day_13th,
+        StringIds::day_14th,
+        StringIds::day_15th,
+        StringIds::day_16th,
+        StringIds::day_17th,
+        StringIds::day_18th,
+        StringIds::day_19th,
+        StringIds::day_20th,
+        StringIds::day_21st,
+        StringIds::day_22nd,
+        StringIds::day_23rd,
+        StringIds::day_24th,
+        StringIds::day_25th,
+        StringIds::day_26th,
+        StringIds::day_27th,
+        StringIds::day_28th,
+        StringIds::day_29th,
+        StringIds::day_30th,
+        StringIds::day_31st,
     };
 
-    static std::map<month_id, std::pair<string_id, string_id>> month_to_string = {
-        { month_id::january, { StringIds::month_short_january, StringIds::month_long_january } },
-        { month_id::february, { StringIds::month_short_february, StringIds::month_long_february } },
-        { month_id::march, { StringIds::month_short_march, StringIds::month_long_march } },
-        { month_id::april, { StringIds::month_short_april, StringIds::month_long_april } },
-        { month_id::may, { StringIds::month_short_may, StringIds::month_long_may } },
-        { month_id::june, { StringIds::month_short_june, StringIds::month_long_june } },
-        { month_id::july, { StringIds::month_short_july, StringIds::month_long_july } },
-        { month_id::august, { StringIds::month_short_august, StringIds::month_long_august } },
-        { month_id::september, { StringIds::month_short_september, StringIds::month_long_september } },
-        { month_id::october, { StringIds::month_short_october, StringIds::month_long_october } },
-        { month_id::november, { StringIds::month_short_november, StringIds::month_long_november } },
-        { month_id::december, { StringIds::month_short_december, StringIds::month_long_december } },
+    // Short and long names indexed by month_id
+    static constexpr std::array<std::pair<string_id, string_id>, 12> monthToString = {
+        std::pair{ StringIds::month_short_january, StringIds::month_long_january },
+        std::pair{ StringIds::month_short_february, StringIds::month_long_february },
+        std::pair{ StringIds::month_short_march, StringIds::month_long_march },
+        std::pair{ StringIds::month_short_april, StringIds::month_long_april },
+        std::pair{ StringIds::month_short_may, StringIds::month_long_may },
+        std::pair{ StringIds::month_short_june, StringIds::month_long_june },
+        std::pair{ StringIds::month_short_july, StringIds::month_long_july },
+        std::pair{ StringIds::month_short_august, StringIds::month_long_august },
+        std::pair{ StringIds::month_short_september, StringIds::month_long_september },
+        std::pair{ StringIds::month_short_october, StringIds::month_long_october },
+        std::pair{ StringIds::month_short_november, StringIds::month_long_november },
+        std::pair{ StringIds::month_short_december, StringIds::month_long_december },
     };
 
+    // A compiled string is a list of operations over its source string. Runs of characters that are copied unchanged,
+    // including the control codes interpreted when drawing, become a single literal op.
+    struct FormatOp
+    {
+        uint8_t code;     // Formatting control code, or 0 for a literal run
+        uint16_t operand; // Inline string id or date modifier following the control code
+        uint32_t offset;  // Literal run within the source string
+        uint32_t length;
+    };
+
+    struct FormatProgram
+    {
+        const char* source = nullptr;
+        uint32_t firstOp = 0;
+        uint32_t numOps = 0;
+    };
+
+    static std::vector<FormatOp> _formatOps;
+    static std::vector<FormatProgram> _formatPrograms;
+
     // 0x0049650E
     void reset()
     {
@@ -152,13 +178,13 @@ namespace OpenLoco::StringManager
     {
         auto date = calcDate(totalDays);
 
-        string_id day_string = day_to_string[date.day];
+        string_id day_string = dayToString[date.day];
         buffer = formatString(buffer, day_string, nullptr);
 
         *buffer = ' ';
         buffer++;
 
-        string_id month_string = month_to_string[date.month].second;
+        string_id month_string = monthToString[static_cast<uint8_t>(date.month)].second;
         buffer = formatString(buffer, month_string, nullptr);
 
         *buffer = ' ';
@@ -174,7 +200,7 @@ namespace OpenLoco::StringManager
     {
         auto date = calcDate(totalDays);
 
-        string_id month_string = month_to_string[date.month].second;
+        string_id month_string = monthToString[static_cast<uint8_t>(date.month)].second;
         buffer = formatString(buffer, month_string, nullptr);
 
         *buffer = ' ';
@@ -190,7 +216,7 @@ namespace OpenLoco::StringManager
     {
         auto date = calcDate(totalDays);
 
-        string_id month_string = month_to_string[date.month].second;
+        string_id month_string = monthToString[static_cast<uint8_t>(date.month)].second;
         buffer = formatString(buffer, month_string, nullptr);
 
         *buffer = ' ';
@@ -205,7 +231,7 @@ namespace OpenLoco::StringManager
     static char* formatRawDateMYAbbrev(uint32_t totalDays, char* buffer)
     {
         auto month = static_cast<month_id>(totalDays % 12);
-        string_id month_string = month_to_string[month].first;
+        string_id month_string = monthToString[static_cast<uint8_t>(month)].first;
         buffer = formatString(buffer, month_string, nullptr);
 
         *buffer = ' ';
@@ -244,294 +270,312 @@ namespace OpenLoco::StringManager
 
     static char* formatString(char* buffer, string_id id, ArgsWrapper& args);
 
-    static char* formatStringPart(char* buffer, const char* sourceStr, ArgsWrapper& args)
+    // Number of characters copied unchanged for a control code or character, 0 for formatting control codes
+    static uint32_t getPassthroughLength(uint8_t ch)
     {
-        while (true)
+        if (ch <= 4)
+            return 2;
+        if (ch <= 16)
+            return 1;
+        if (ch <= 22)
+            return 3;
+        if (ch <= 0x1F)
+            return 5;
+        if (ch < 0x7B || ch >= 0x90)
+            return 1;
+        return 0;
+    }
+
+    // Reads the inline operand following a formatting control code, returning its size in characters
+    static uint32_t readOperand(uint8_t code, const char* sourceStr, uint16_t& operand)
+    {
+        switch (code)
         {
-            uint8_t ch = *sourceStr;
+            case ControlCodes::stringid_str:
+                std::memcpy(&operand, sourceStr, sizeof(string_id));
+                return sizeof(string_id);
 
-            if (ch == 0)
+            case ControlCodes::date:
+                operand = static_cast<uint8_t>(*sourceStr);
+                return 1;
+
+            default:
+                operand = 0;
+                return 0;
+        }
+    }
+
+    static char* formatControlCode(char* buffer, uint8_t code, uint16_t operand, ArgsWrapper& args)
+    {
+        switch (code)
+        {
+            case ControlCodes::int32_grouped:
             {
-                *buffer = '\0';
-                return buffer;
+                int32_t value = args.pop<int32_t>();
+                buffer = formatInt32Grouped(value, buffer);
+                break;
             }
-            else if (ch <= 4)
+
+            case ControlCodes::int32_ungrouped:
             {
-                std::memcpy(buffer, sourceStr, 2);
-                buffer += 2;
-                sourceStr += 2;
+                int32_t value = args.pop<int32_t>();
+                buffer = formatInt32Ungrouped(value, buffer);
+                break;
             }
-            else if (ch <= 16)
+
+            case ControlCodes::int16_decimals:
             {
-                std::memcpy(buffer, sourceStr, 1);
-                buffer += 1;
-                sourceStr += 1;
+                int16_t value = args.pop<int16_t>();
+                buffer = formatShortWithDecimals(value, buffer);
+                break;
             }
-            else if (ch <= 22)
+
+            case ControlCodes::int32_decimals:
             {
-                std::memcpy(buffer, sourceStr, 3);
-                buffer += 3;
-                sourceStr += 3;
+                int32_t value = args.pop<int32_t>();
+                buffer = formatIntWithDecimals(value, buffer);
+                break;
             }
-            else if (ch <= 0x1F)
+
+            case ControlCodes::int16_grouped:
             {
-                std::memcpy(buffer, sourceStr, 5);
-                buffer += 5;
-                sourceStr += 5;
+                int16_t value = args.pop<int16_t>();
+                buffer = formatInt32Grouped(value, buffer);
+                break;
             }
-            else if (ch < 0x7B || ch >= 0x90)
+
+            case ControlCodes::uint16_ungrouped:
             {
-                std::memcpy(buffer, sourceStr, 1);
-                buffer += 1;
-                sourceStr += 1;
+                int32_t value = args.pop<uint16_t>();
+                buffer = formatInt32Ungrouped(value, buffer);
+                break;
             }
-            else
+
+            case ControlCodes::currency32:
             {
-                sourceStr++;
+                int32_t value = args.pop<uint32_t>();
+                buffer = formatCurrency(value, buffer);
+                break;
+            }
 
-                switch (ch)
-                {
-                    case ControlCodes::int32_grouped:
-                    {
-                        int32_t value = args.pop<int32_t>();
-                        buffer = formatInt32Grouped(value, buffer);
-                        break;
-                    }
+            case ControlCodes::currency48:
+            {
+                uint32_t value_low = args.pop<uint32_t>();
+                int32_t value_high = args.pop<int16_t>();
+                int64_t value = (value_high * (1ULL << 32)) | value_low;
+                buffer = formatCurrency(value, buffer);
+                break;
+            }
 
-                    case ControlCodes::int32_ungrouped:
-                    {
-                        int32_t value = args.pop<int32_t>();
-                        buffer = formatInt32Ungrouped(value, buffer);
-                        break;
-                    }
+            case ControlCodes::stringid_args:
+            {
+                string_id id = args.pop<string_id>();
+                buffer = formatString(buffer, id, args);
+                break;
+            }
 
-                    case ControlCodes::int16_decimals:
-                    {
-                        int16_t value = args.pop<int16_t>();
-                        buffer = formatShortWithDecimals(value, buffer);
-                        break;
-                    }
+            case ControlCodes::stringid_str:
+            {
+                buffer = formatString(buffer, operand, args);
+                break;
+            }
 
-                    case ControlCodes::int32_decimals:
-                    {
-                        int32_t value = args.pop<int32_t>();
-                        buffer = formatIntWithDecimals(value, buffer);
-                        break;
-                    }
+            case ControlCodes::string_ptr:
+            {
+                const char* str = args.pop<const char*>();
+                strcpy(buffer, str);
+                buffer += strlen(str);
+                break;
+            }
 
-                    case ControlCodes::int16_grouped:
-                    {
-                        int16_t value = args.pop<int16_t>();
-                        buffer = formatInt32Grouped(value, buffer);
-                        break;
-                    }
+            case ControlCodes::date:
+            {
+                uint32_t totalDays = args.pop<uint32_t>();
 
-                    case ControlCodes::uint16_ungrouped:
-                    {
-                        int32_t value = args.pop<uint16_t>();
-                        buffer = formatInt32Ungrouped(value, buffer);
+                switch (operand)
+                {
+                    case DateModifier::dmy_full:
+                        buffer = formatDateDMYFull(totalDays, buffer);
                         break;
-                    }
 
-                    case ControlCodes::currency32:
-                    {
-                        int32_t value = args.pop<uint32_t>();
-                        buffer = formatCurrency(value, buffer);
+                    case DateModifier::my_full:
+                        buffer = formatDateMYFull(totalDays, buffer);
                         break;
-                    }
-
-                    case ControlCodes::currency48:
-                    {
-                        uint32_t value_low = args.pop<uint32_t>();
-                        int32_t value_high = args.pop<int16_t>();
-                        int64_t value = (value_high * (1ULL << 32)) | value_low;
-                        buffer = formatCurrency(value, buffer);
-                        break;
-                    }
 
-                    case ControlCodes::stringid_args:
-                    {
-                        string_id id = args.pop<string_id>();
-                        buffer = formatString(buffer, id, args);
+                    case DateModifier::my_abbr:
+                        buffer = formatDateMYAbbrev(totalDays, buffer);
                         break;
-                    }
 
-                    case ControlCodes::stringid_str:
-                    {
-                        string_id id = *(string_id*)sourceStr;
-                        sourceStr += 2;
-                        buffer = formatString(buffer, id, args);
+                    case DateModifier::raw_my_abbr:
+                        buffer = formatRawDateMYAbbrev(totalDays, buffer);
                         break;
-                    }
 
-                    case ControlCodes::string_ptr:
-                    {
-                        const char* str = args.pop<const char*>();
-                        strcpy(buffer, str);
-                        buffer += strlen(str);
-                        break;
-                    }
+                    default:
+                        throw std::out_of_range("formatString: unexpected modifier: " + std::to_string(operand));
+                }
 
-                    case ControlCodes::date:
-                    {
-                        char modifier = *sourceStr;
-                        uint32_t totalDays = args.pop<uint32_t>();
-                        sourceStr++;
+                break;
+            }
 
-                        switch (modifier)
-                        {
-                            case DateModifier::dmy_full:
-                                buffer = formatDateDMYFull(totalDays, buffer);
-                                break;
+            case ControlCodes::velocity:
+            {
+                auto measurement_format = Config::get().measurement_format;
 
-                            case DateModifier::my_full:
-                                buffer = formatDateMYFull(totalDays, buffer);
-                                break;
+                int32_t value = args.pop<int16_t>();
+
+                const char* unit;
+                if (measurement_format == Config::MeasurementFormat::imperial)
+                {
+                    unit = getString(StringIds::unit_mph);
+                }
+                else
+                {
+                    unit = getString(StringIds::unit_kmh);
+                    value = std::round(value * 1.609375);
+                }
 
-                            case DateModifier::my_abbr:
-                                buffer = formatDateMYAbbrev(totalDays, buffer);
-                                break;
+                buffer = formatInt32Grouped(value, buffer);
 
-                            case DateModifier::raw_my_abbr:
-                                buffer = formatRawDateMYAbbrev(totalDays, buffer);
-                                break;
+                strcpy(buffer, unit);
+                buffer += strlen(unit);
 
-                            default:
-                                throw std::out_of_range("formatString: unexpected modifier: " + std::to_string((uint8_t)modifier));
-                        }
+                break;
+            }
 
-                        break;
-                    }
+            case ControlCodes::pop16:
+                args.skip<uint16_t>();
+                break;
 
-                    case ControlCodes::velocity:
-                    {
-                        auto measurement_format = Config::get().measurement_format;
+            case ControlCodes::push16:
+                args.push<uint16_t>();
+                break;
 
-                        int32_t value = args.pop<int16_t>();
+            case ControlCodes::timeMS:
+                throw std::runtime_error("Unimplemented format string: 15");
 
-                        const char* unit;
-                        if (measurement_format == Config::MeasurementFormat::imperial)
-                        {
-                            unit = getString(StringIds::unit_mph);
-                        }
-                        else
-                        {
-                            unit = getString(StringIds::unit_kmh);
-                            value = std::round(value * 1.609375);
-                        }
+            case ControlCodes::timeHM:
+                throw std::runtime_error("Unimplemented format string: 16");
 
-                        buffer = formatInt32Grouped(value, buffer);
+            case ControlCodes::distance:
+            {
+                uint32_t value = args.pop<uint16_t>();
+                auto measurement_format = Config::get().measurement_format;
 
-                        strcpy(buffer, unit);
-                        buffer += strlen(unit);
+                const char* unit;
+                if (measurement_format == Config::MeasurementFormat::imperial)
+                {
+                    unit = getString(StringIds::unit_ft);
+                    value = std::round(value * 3.28125);
+                }
+                else
+                {
+                    unit = getString(StringIds::unit_m);
+                }
 
-                        break;
-                    }
+                buffer = formatInt32Grouped(value, buffer);
 
-                    case ControlCodes::pop16:
-                        args.skip<uint16_t>();
-                        break;
+                strcpy(buffer, unit);
+                buffer += strlen(unit);
 
-                    case ControlCodes::push16:
-                        args.push<uint16_t>();
-                        break;
+                break;
+            }
 
-                    case ControlCodes::timeMS:
-                        throw std::runtime_error("Unimplemented format string: 15");
+            case ControlCodes::height:
+            {
+                int32_t value = args.pop<int16_t>();
 
-                    case ControlCodes::timeHM:
-                        throw std::runtime_error("Unimplemented format string: 16");
+                bool showHeightAsUnits = Config::get().flags & Config::Flags::showHeightAsUnits;
+                auto measurement_format = Config::get().measurement_format;
+                const char* unit;
 
-                    case ControlCodes::distance:
-                    {
-                        uint32_t value = args.pop<uint16_t>();
-                        auto measurement_format = Config::get().measurement_format;
+                if (showHeightAsUnits)
+                {
+                    unit = getString(StringIds::unit_units);
+                }
+                else if (measurement_format == Config::MeasurementFormat::imperial)
+                {
+                    unit = getString(StringIds::unit_ft);
+                    value *= 16;
+                }
+                else
+                {
+                    unit = getString(StringIds::unit_m);
+                    value *= 5;
+                }
 
-                        const char* unit;
-                        if (measurement_format == Config::MeasurementFormat::imperial)
-                        {
-                            unit = getString(StringIds::unit_ft);
-                            value = std::round(value * 3.28125);
-                        }
-                        else
-                        {
-                            unit = getString(StringIds::unit_m);
-                        }
+                buffer = formatInt32Grouped(value, buffer);
 
-                        buffer = formatInt32Grouped(value, buffer);
+                strcpy(buffer, unit);
+                buffer += strlen(unit);
 
-                        strcpy(buffer, unit);
-                        buffer += strlen(unit);
+                break;
+            }
 
-                        break;
-                    }
-
-                    case ControlCodes::height:
-                    {
-                        int32_t value = args.pop<int16_t>();
-
-                        bool showHeightAsUnits = Config::get().flags & Config::Flags::showHeightAsUnits;
-                        auto measurement_format = Config::get().measurement_format;
-                        const char* unit;
-
-                        if (showHeightAsUnits)
-                        {
-                            unit = getString(StringIds::unit_units);
-                        }
-                        else if (measurement_format == Config::MeasurementFormat::imperial)
-                        {
-                            unit = getString(StringIds::unit_ft);
-                            value *= 16;
-                        }
-                        else
-                        {
-                            unit = getString(StringIds::unit_m);
-                            value *= 5;
-                        }
-
-                        buffer = formatInt32Grouped(value, buffer);
-
-                        strcpy(buffer, unit);
-                        buffer += strlen(unit);
+            case ControlCodes::power:
+            {
+                uint32_t value = args.pop<int16_t>();
+                auto measurement_format = Config::get().measurement_format;
 
-                        break;
-                    }
+                const char* unit;
+                if (measurement_format == Config::MeasurementFormat::imperial)
+                {
+                    unit = getString(StringIds::unit_hp);
+                }
+                else
+                {
+                    unit = getString(StringIds::unit_kW);
+                    value = std::round(value * 0.746);
+                }
 
-                    case ControlCodes::power:
-                    {
-                        uint32_t value = args.pop<int16_t>();
-                        auto measurement_format = Config::get().measurement_format;
+                buffer = formatInt32Grouped(value, buffer);
 
-                        const char* unit;
-                        if (measurement_format == Config::MeasurementFormat::imperial)
-                        {
-                            unit = getString(StringIds::unit_hp);
-                        }
-                        else
-                        {
-                            unit = getString(StringIds::unit_kW);
-                            value = std::round(value * 0.746);
-                        }
+                strcpy(buffer, unit);
+                buffer += strlen(unit);
 
-                        buffer = formatInt32Grouped(value, buffer);
+                break;
+            }
 
-                        strcpy(buffer, unit);
-                        buffer += strlen(unit);
+            case ControlCodes::inline_sprite_args:
+            {
+                *buffer = ControlCodes::inline_sprite_str;
+                uint32_t value = args.pop<uint32_t>();
+                uint32_t* sprite_ptr = (uint32_t*)(buffer + 1);
+                *sprite_ptr = value;
+                buffer += 5;
 
-                        break;
-                    }
+                break;
+            }
+        }
 
-                    case ControlCodes::inline_sprite_args:
-                    {
-                        *buffer = ControlCodes::inline_sprite_str;
-                        uint32_t value = args.pop<uint32_t>();
-                        uint32_t* sprite_ptr = (uint32_t*)(buffer + 1);
-                        *sprite_ptr = value;
-                        buffer += 5;
+        return buffer;
+    }
 
-                        break;
-                    }
-                }
+    static char* formatStringPart(char* buffer, const char* sourceStr, ArgsWrapper& args)
+    {
+        while (true)
+        {
+            uint8_t ch = *sourceStr;
+
+            if (ch == 0)
+            {
+                *buffer = '\0';
+                return buffer;
+            }
+
+            const auto length = getPassthroughLength(ch);
+            if (length != 0)
+            {
+                std::memcpy(buffer, sourceStr, length);
+                buffer += length;
+                sourceStr += length;
+            }
+            else
+            {
+                sourceStr++;
+
+                uint16_t operand;
+                sourceStr += readOperand(ch, sourceStr, operand);
+                buffer = formatControlCode(buffer, ch, operand, args);
             }
         }
     }
@@ -542,6 +586,93 @@ namespace OpenLoco::StringManager
         return formatStringPart(buffer, sourceStr, wrapped);
     }
 
+    static void compileString(FormatProgram& program, const char* sourceStr)
+    {
+        program.source = sourceStr;
+        program.firstOp = static_cast<uint32_t>(_formatOps.size());
+
+        uint32_t offset = 0;
+        while (sourceStr[offset] != '\0')
+        {
+            const uint8_t ch = sourceStr[offset];
+            const auto length = getPassthroughLength(ch);
+            if (length != 0)
+            {
+                if (_formatOps.size() > program.firstOp && _formatOps.back().code == 0)
+                {
+                    _formatOps.back().length += length;
+                }
+                else
+                {
+                    _formatOps.push_back({ 0, 0, offset, length });
+                }
+                offset += length;
+            }
+            else
+            {
+                offset++;
+
+                uint16_t operand;
+                offset += readOperand(ch, sourceStr + offset, operand);
+                _formatOps.push_back({ ch, operand, 0, 0 });
+            }
+        }
+
+        program.numOps = static_cast<uint32_t>(_formatOps.size()) - program.firstOp;
+    }
+
+    // Strings from the language files are compiled the first time they are formatted. Other strings, such as
+    // object names and buffers, may change behind the same pointer so are always interpreted.
+    static const FormatProgram* getCompiledString(string_id id, const char* sourceStr)
+    {
+        if (!Localisation::isLanguageString(id))
+        {
+            return nullptr;
+        }
+
+        if (_formatPrograms.empty())
+        {
+            _formatPrograms.resize(USER_STRINGS_START);
+        }
+
+        auto& program = _formatPrograms[id];
+        if (program.source != sourceStr)
+        {
+            compileString(program, sourceStr);
+        }
+        return &program;
+    }
+
+    static char* formatCompiledString(char* buffer, const FormatProgram& program, ArgsWrapper& args)
+    {
+        // Nested strings may be compiled while this one runs, so ops are copied out rather than referenced
+        const auto* sourceStr = program.source;
+        const auto firstOp = program.firstOp;
+        const auto numOps = program.numOps;
+        for (uint32_t i = 0; i < numOps; i++)
+        {
+            const auto op = _formatOps[firstOp + i];
+            if (op.code == 0)
+            {
+                std::memcpy(buffer, sourceStr + op.offset, op.length);
+                buffer += op.length;
+            }
+            else
+            {
+                buffer = formatControlCode(buffer, op.code, op.operand, args);
+            }
+        }
+
+        *buffer = '\0';
+        return buffer;
+    }
+
+    void invalidateCompiledStrings()
+    {
+        _formatOps.clear();
+        _formatPrograms.clear();
+    }
+
     // 0x004958C6
     static char* formatString(char* buffer, string_id id, ArgsWrapper& args)
     {
@@ -553,7 +684,15 @@ namespace OpenLoco::StringManager
                 throw std::runtime_error("Got a nullptr for string id " + std::to_string(id) + " -- cowardly refusing");
             }
 
-            buffer = formatStringPart(buffer, sourceStr, args);
+            auto* program = getCompiledString(id, sourceStr);
+            if (program != nullptr)
+            {
+                buffer = formatCompiledString(buffer, *program, args);
+            }
+            else
+            {
+                buffer = formatStringPart(buffer, sourceStr, args);
+            }
             assert(*buffer == '\0');
             return buffer;
         }
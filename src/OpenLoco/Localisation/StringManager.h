@@ -114,6 +114,7 @@ namespace OpenLoco::StringManager
     const char* getString(string_id id);
     char* formatString(char* buffer, string_id id, const void* args = nullptr);
     char* formatString(char* buffer, size_t bufferLen, string_id id, const void* args = nullptr);
+    void invalidateCompiledStrings();
     string_id userStringAllocate(char* str, uint8_t cl);
     void emptyUserString(string_id stringId);
     string_id isTownName(string_id stringId);
@@ -1,15 +1,18 @@
 #include "MapGenerator.h"
+#include "../Console.h"
 #include "../Interop/Interop.hpp"
 #include "../Localisation/StringIds.h"
 #include "../S5/S5.h"
 #include "../Scenario.h"
 #include "../Ui/ProgressBar.h"
 #include "../Ui/WindowManager.h"
+#include "../Utility/Parallel.hpp"
 #include "Tile.h"
 #include "TileLoop.hpp"
 #include "TileManager.h"
 #include <cassert>
 #include <cstdint>
+#include <chrono>
 #include <random>
 #include <vector>
 
@@ -219,61 +222,75 @@ namespace OpenLoco::Map::MapGenerator
             auto freq = settings.baseFreq * (1.0f / std::max(heightMap.width, heightMap.height));
             uint8_t perm[512];
             noise(perm, std::size(perm));
-            for (int32_t y = 0; y < heightMap.height; y++)
-            {
+
+            // Rows only depend on the permutation table, so they can be generated in any order
+            Utility::parallelFor(0, heightMap.height, [&](int32_t y) {
+                auto row = std::vector<float>(heightMap.width);
+                noiseFractalRow(perm, y, heightMap.width, freq, settings.octaves, 2.0f, 0.65f, row.data());
                 for (int32_t x = 0; x < heightMap.width; x++)
                 {
-                    auto noiseValue = std::clamp(noiseFractal(perm, x, y, freq, settings.octaves, 2.0f, 0.65f), -1.0f, 1.0f);
+                    auto noiseValue = std::clamp(row[x], -1.0f, 1.0f);
                     auto normalisedNoiseValue = (noiseValue + 1.0f) / 2.0f;
                     auto height = settings.low + static_cast<int32_t>(normalisedNoiseValue * settings.high);
                     heightMap[{ x, y }] = height;
                 }
-            }
+            });
         }
 
         static void smooth(int32_t iterations, HeightMapRange heightMap)
         {
+            // Each pass reads from a copy of the heights left by the previous pass
+            auto copyHeight = std::vector<uint8_t>(heightMap.width * heightMap.height);
             for (int32_t i = 0; i < iterations; i++)
             {
-                auto copyHeight = heightMap;
-                for (int32_t y = 1; y < heightMap.width - 1; y++)
+                for (int32_t y = 0; y < heightMap.height; y++)
                 {
-                    for (int32_t x = 1; x < heightMap.height - 1; x++)
+                    for (int32_t x = 0; x < heightMap.width; x++)
+                    {
+                        copyHeight[y * heightMap.width + x] = heightMap[{ x, y }];
+                    }
+                }
+
+                Utility::parallelFor(1, heightMap.height - 1, [&](int32_t y) {
+                    for (int32_t x = 1; x < heightMap.width - 1; x++)
                     {
                         int32_t total = 0;
                         for (int32_t yy = -1; yy <= 1; yy++)
                         {
                             for (int32_t xx = -1; xx <= 1; xx++)
                             {
-                                total += copyHeight[{ x + xx, y + yy }];
+                                total += copyHeight[(y + yy) * heightMap.width + x + xx];
                             }
                         }
                         heightMap[{ x, y }] = total / 9;
                     }
-                }
+                });
             }
         }
 
-        static float noiseFractal(uint8_t* perm, int32_t x, int32_t y, float frequency, int32_t octaves, float lacunarity, float persistence)
+        // Sums the octaves of noise for a whole row at once. Octaves are accumulated in the same
+        // order as for a single point, so results do not depend on how rows are split up.
+        static void noiseFractalRow(const uint8_t* perm, int32_t y, int32_t width, float frequency, int32_t octaves, float lacunarity, float persistence, float* out)
         {
-            float total = 0.0f;
+            std::fill_n(out, width, 0.0f);
             float amplitude = persistence;
             for (int32_t i = 0; i < octaves; i++)
             {
-                total += generateNoise(perm, x * frequency, y * frequency) * amplitude;
+                const float fy = y * frequency;
+                for (int32_t x = 0; x < width; x++)
+                {
+                    out[x] += generateNoise(perm, x * frequency, fy) * amplitude;
+                }
                 frequency *= lacunarity;
                 amplitude *= persistence;
             }
-            return total;
         }
 
-        static float generateNoise(uint8_t* perm, float x, float y)
+        static float generateNoise(const uint8_t* perm, float x, float y)
         {
             const float F2 = 0.366025403f; // F2 = 0.5*(sqrt(3.0)-1.0)
             const float G2 = 0.211324865f; // G2 = (3.0-sqrt(3.0))/6.0
 
-            float n0, n1, n2; // Noise contributions from the three corners
-
             // Skew the input space to determine which simplex cell we're in
             float s = (x + y) * F2; // Hairy factor for 2D
             float xs = x + s;
@@ -289,17 +306,10 @@ namespace OpenLoco::Map::MapGenerator
 
             // For the 2D case, the simplex shape is an equilateral triangle.
             // Determine which simplex we are in.
-            int32_t i1, j1; // Offsets for second (middle) corner of simplex in (i,j) coords
-            if (x0 > y0)
-            {
-                i1 = 1;
-                j1 = 0;
-            } // lower triangle, XY order: (0,0)->(1,0)->(1,1)
-            else
-            {
-                i1 = 0;
-                j1 = 1;
-            } // upper triangle, YX order: (0,0)->(0,1)->(1,1)
+            // lower triangle, XY order: (0,0)->(1,0)->(1,1)
+            // upper triangle, YX order: (0,0)->(0,1)->(1,1)
+            int32_t i1 = x0 > y0 ? 1 : 0; // Offsets for second (middle) corner of simplex in (i,j) coords
+            int32_t j1 = 1 - i1;
 
             // A step of (1,0) in (i,j) means a step of (1-c,-c) in (x,y), and
             // a step of (0,1) in (i,j) means a step of (-c,1-c) in (x,y), where
@@ -314,39 +324,19 @@ namespace OpenLoco::Map::MapGenerator
             int32_t ii = i % 256;
             int32_t jj = j % 256;
 
-            // Calculate the contribution from the three corners
-            float t0 = 0.5f - x0 * x0 - y0 * y0;
-            if (t0 < 0.0f)
-            {
-                n0 = 0.0f;
-            }
-            else
-            {
-                t0 *= t0;
-                n0 = t0 * t0 * grad(perm[ii + perm[jj]], x0, y0);
-            }
+            // Calculate the contribution from the three corners, corners out of range contribute nothing.
+            // Written without branches so that the compiler is free to vectorise the row loops.
+            float t0 = std::max(0.5f - x0 * x0 - y0 * y0, 0.0f);
+            t0 *= t0;
+            float n0 = t0 * t0 * grad(perm[ii + perm[jj]], x0, y0);
 
-            float t1 = 0.5f - x1 * x1 - y1 * y1;
-            if (t1 < 0.0f)
-            {
-                n1 = 0.0f;
-            }
-            else
-            {
-                t1 *= t1;
-                n1 = t1 * t1 * grad(perm[ii + i1 + perm[jj + j1]], x1, y1);
-            }
+            float t1 = std::max(0.5f - x1 * x1 - y1 * y1, 0.0f);
+            t1 *= t1;
+            float n1 = t1 * t1 * grad(perm[ii + i1 + perm[jj + j1]], x1, y1);
 
-            float t2 = 0.5f - x2 * x2 - y2 * y2;
-            if (t2 < 0.0f)
-            {
-                n2 = 0.0f;
-            }
-            else
-            {
-                t2 *= t2;
-                n2 = t2 * t2 * grad(perm[ii + 1 + perm[jj + 1]], x2, y2);
-            }
+            float t2 = std::max(0.5f - x2 * x2 - y2 * y2, 0.0f);
+            t2 *= t2;
+            float n2 = t2 * t2 * grad(perm[ii + 1 + perm[jj + 1]], x2, y2);
 
             // Add contributions from each corner to get the final noise value.
             // The result is scaled to return values in the interval [-1,1].
@@ -388,6 +378,8 @@ namespace OpenLoco::Map::MapGenerator
     // 0x004624F0
     static void generateHeightMap(const S5::Options& options, HeightMap& heightMap)
     {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
         if (options.generator == LandGeneratorType::Original)
         {
             OriginalTerrainGenerator generator;
@@ -396,8 +388,11 @@ namespace OpenLoco::Map::MapGenerator
         else
         {
             ModernTerrainGenerator generator;
-            generator.generate(options, heightMap, std::random_device{}());
+            generator.generate(options, heightMap, options.generatedSeed);
         }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - startTime);
+        Console::logVerbose("Generated height map with seed %u in %d us", options.generatedSeed, static_cast<int32_t>(elapsed.count()));
     }
 
     // 0x004625D0
@@ -512,6 +507,7 @@ namespace OpenLoco::Map::MapGenerator
             generateTerrain(heightMap);
             updateProgress(35);
         }
+        TileManager::invalidateCaches();
 
         call(0x004611DF);
         updateProgress(40);
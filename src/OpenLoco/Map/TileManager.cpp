@@ -1,8 +1,14 @@
 #include "TileManager.h"
+#include "../GameCommands/GameCommands.h"
 #include "../Input.h"
 #include "../Interop/Interop.hpp"
+#include "../Localisation/StringIds.h"
 #include "../Map/Map.hpp"
 #include "../ViewportManager.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
 
 using namespace OpenLoco::Interop;
 
@@ -32,16 +38,39 @@ namespace OpenLoco::Map::TileManager
     static loco_global<int16_t, 0x0050A000> _adjustToolSize;
     static loco_global<uint16_t, 0x00525F6C> _numAnimations;
     static loco_global<TileAnimation[maxAnimations], 0x0094C6DC> _animations;
+    static loco_global<uint8_t, 0x00508F08> _gameCommandNestLevel;
 
     constexpr uint16_t mapSelectedTilesSize = 300;
     static loco_global<Pos2[mapSelectedTilesSize], 0x00F24490> _mapSelectedTiles;
 
     static TileElement* InvalidTile = reinterpret_cast<TileElement*>(static_cast<intptr_t>(-1));
 
+    // Backing storage for _elements, sized by maxElements rather than the original fixed 0x360000 bytes
+    static std::vector<TileElement> _elementBuffer;
+
+    // Elements that must stay free for a game command to be allowed to insert more
+    constexpr size_t minFreeElements = 0x400;
+
+    // 0x004BF476
+    void allocateElements()
+    {
+        try
+        {
+            _elementBuffer.resize(maxElements);
+        }
+        catch (const std::bad_alloc&)
+        {
+            exitWithError(StringIds::unable_to_allocate_enough_memory, StringIds::null);
+            return;
+        }
+        _elements = _elementBuffer.data();
+    }
+
     // 0x00461179
     void initialise()
     {
         call(0x00461179);
+        invalidateCaches();
     }
 
     stdx::span<TileElement> getElements()
@@ -54,11 +83,20 @@ namespace OpenLoco::Map::TileManager
         return _elementsEnd;
     }
 
+    stdx::span<TileElement> getElementStorage()
+    {
+        return stdx::span<TileElement>(_elements, maxElements);
+    }
+
+    // Elements may already be at the start of the element storage, in which case only the rest is cleared
     void setElements(stdx::span<TileElement> elements)
     {
         TileElement* dst = _elements;
-        std::memset(dst, 0, maxElements * sizeof(TileElement));
-        std::memcpy(dst, elements.data(), elements.size_bytes());
+        if (elements.data() != dst)
+        {
+            std::memcpy(dst, elements.data(), elements.size_bytes());
+        }
+        std::memset(dst + elements.size(), 0, (maxElements - elements.size()) * sizeof(TileElement));
         TileManager::updateTilePointers();
     }
 
@@ -88,37 +126,11 @@ namespace OpenLoco::Map::TileManager
         return get(TilePos2(x / Map::tile_size, y / Map::tile_size));
     }
 
-    /**
-     * Return the absolute height of an element, given its (x, y) coordinates
-     * remember to & with 0xFFFF if you don't want water affecting results
-     *
-     * @param x @<ax>
-     * @param y @<cx>
-     * @return height @<edx>
-     *
-     * 0x00467297 rct2: 0x00662783 (numbers different)
-     */
-    TileHeight getHeight(const Pos2& pos)
+    // Height of the land above the surface element base for the given subtile coordinates
+    static coord_t calculateSlopeHeightOffset(uint8_t slope, int32_t xl, int32_t yl)
     {
-        TileHeight height{ 16, 0 };
-        // Off the map
-        if ((unsigned)pos.x >= (Map::map_width - 1) || (unsigned)pos.y >= (Map::map_height - 1))
-            return height;
-
-        auto tile = TileManager::get(pos);
-        // Get the surface element for the tile
-        auto surfaceEl = tile.surface();
-
-        if (surfaceEl == nullptr)
-        {
-            return height;
-        }
-
-        height.waterHeight = surfaceEl->water() * 16;
-        height.landHeight = surfaceEl->baseZ() * 4;
-
-        const auto slope = surfaceEl->slopeCorners();
-        if (slope == SurfaceSlope::flat)
+        coord_t height = 0;
+        if ((slope & SurfaceSlope::all_corners_up) == SurfaceSlope::flat)
         {
             // Flat surface requires no further calculations.
             return height;
@@ -130,10 +142,6 @@ namespace OpenLoco::Map::TileManager
 
         constexpr uint8_t TILE_SIZE = 31;
 
-        // Subtile coords
-        const auto xl = pos.x & 0x1f;
-        const auto yl = pos.y & 0x1f;
-
         // Slope logic:
         // Each of the four bits in slope represents that corner being raised
         // slope == 15 (all four bits) is not used and slope == 0 is flat
@@ -142,7 +150,7 @@ namespace OpenLoco::Map::TileManager
         // We arbitrarily take the SW corner to be closest to the viewer
 
         // One corner up
-        switch (slope)
+        switch (slope & SurfaceSlope::all_corners_up)
         {
             case SurfaceSlope::n_corner_up:
                 quad = xl + yl - TILE_SIZE;
@@ -160,29 +168,29 @@ namespace OpenLoco::Map::TileManager
         // If the element is in the quadrant with the slope, raise its height
         if (quad > 0)
         {
-            height.landHeight += quad / 2;
+            height += quad / 2;
         }
 
         // One side up
-        switch (slope)
+        switch (slope & SurfaceSlope::all_corners_up)
         {
             case SurfaceSlope::ne_side_up:
-                height.landHeight += xl / 2 + 1;
+                height += xl / 2 + 1;
                 break;
             case SurfaceSlope::se_side_up:
-                height.landHeight += (TILE_SIZE - yl) / 2;
+                height += (TILE_SIZE - yl) / 2;
                 break;
             case SurfaceSlope::nw_side_up:
-                height.landHeight += yl / 2;
-                height.landHeight++;
+                height += yl / 2;
+                height++;
                 break;
             case SurfaceSlope::sw_side_up:
-                height.landHeight += (TILE_SIZE - xl) / 2;
+                height += (TILE_SIZE - xl) / 2;
                 break;
         }
 
         // One corner down
-        switch (slope)
+        switch (slope & SurfaceSlope::all_corners_up)
         {
             case SurfaceSlope::w_corner_dn:
                 quad_extra = xl + TILE_SIZE - yl;
@@ -202,23 +210,23 @@ namespace OpenLoco::Map::TileManager
                 break;
         }
 
-        if (surfaceEl->isSlopeDoubleHeight())
+        if (slope & SurfaceSlope::double_height)
         {
-            height.landHeight += quad_extra / 2;
-            height.landHeight++;
+            height += quad_extra / 2;
+            height++;
             return height;
         }
 
         // This tile is essentially at the next height level
-        height.landHeight += 0x10;
+        height += 0x10;
         // so we move *down* the slope
         if (quad < 0)
         {
-            height.landHeight += quad / 2;
+            height += quad / 2;
         }
 
         // Valleys
-        switch (slope)
+        switch (slope & SurfaceSlope::all_corners_up)
         {
             case SurfaceSlope::w_e_valley:
                 if (xl + yl <= TILE_SIZE + 1)
@@ -234,12 +242,120 @@ namespace OpenLoco::Map::TileManager
 
         if (quad > 0)
         {
-            height.landHeight += quad / 2;
+            height += quad / 2;
         }
 
         return height;
     }
 
+    // Land height offsets for every surface slope (including the double height flag) and subtile position
+    using SlopeHeightTable = std::array<std::array<int8_t, tile_size * tile_size>, 32>;
+
+    static const SlopeHeightTable& getSlopeHeightTable()
+    {
+        static const SlopeHeightTable table = []() {
+            SlopeHeightTable result{};
+            for (uint8_t slope = 0; slope < result.size(); slope++)
+            {
+                for (int32_t yl = 0; yl < tile_size; yl++)
+                {
+                    for (int32_t xl = 0; xl < tile_size; xl++)
+                    {
+                        result[slope][yl * tile_size + xl] = static_cast<int8_t>(calculateSlopeHeightOffset(slope, xl, yl));
+                    }
+                }
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    // Surface element data, copied out of the tile elements on first use after each invalidation
+    struct HeightCacheEntry
+    {
+        uint8_t baseZ;
+        uint8_t slope; // noSurface if the tile has no surface element
+        uint8_t water;
+        uint8_t generation; // Entry is only valid if it matches _heightCacheGeneration
+    };
+    static_assert(sizeof(HeightCacheEntry) == 4);
+
+    constexpr uint8_t noSurface = 0xFF;
+
+    static std::array<HeightCacheEntry, map_size> _heightCache;
+    static uint8_t _heightCacheGeneration = 1;
+
+    void invalidateHeightCache()
+    {
+        _heightCacheGeneration++;
+        if (_heightCacheGeneration == 0)
+        {
+            // Generation has wrapped around, make sure no stale entries can match again
+            std::fill(_heightCache.begin(), _heightCache.end(), HeightCacheEntry{ 0, noSurface, 0, 0 });
+            _heightCacheGeneration = 1;
+        }
+    }
+
+    static HeightCacheEntry readHeightCacheEntry(const TilePos2& pos)
+    {
+        HeightCacheEntry entry{ 0, noSurface, 0, _heightCacheGeneration };
+        auto surfaceEl = get(pos).surface();
+        if (surfaceEl != nullptr)
+        {
+            entry.baseZ = surfaceEl->baseZ();
+            entry.slope = surfaceEl->slope();
+            entry.water = surfaceEl->water();
+        }
+        return entry;
+    }
+
+    static HeightCacheEntry getHeightCacheEntry(const TilePos2& pos)
+    {
+        if (_gameCommandNestLevel != 0)
+        {
+            return readHeightCacheEntry(pos);
+        }
+
+        auto& entry = _heightCache[pos.y * map_columns + pos.x];
+        if (entry.generation != _heightCacheGeneration)
+        {
+            entry = readHeightCacheEntry(pos);
+        }
+        return entry;
+    }
+
+    /**
+     * Return the absolute height of an element, given its (x, y) coordinates
+     * remember to & with 0xFFFF if you don't want water affecting results
+     *
+     * @param x @<ax>
+     * @param y @<cx>
+     * @return height @<edx>
+     *
+     * 0x00467297 rct2: 0x00662783 (numbers different)
+     */
+    TileHeight getHeight(const Pos2& pos)
+    {
+        TileHeight height{ 16, 0 };
+        // Off the map
+        if ((unsigned)pos.x >= (Map::map_width - 1) || (unsigned)pos.y >= (Map::map_height - 1))
+            return height;
+
+        const auto entry = getHeightCacheEntry(TilePos2(pos));
+        if (entry.slope == noSurface)
+        {
+            return height;
+        }
+
+        // Subtile coords
+        const auto xl = pos.x & 0x1f;
+        const auto yl = pos.y & 0x1f;
+
+        height.waterHeight = entry.water * 16;
+        height.landHeight = entry.baseZ * 4 + getSlopeHeightTable()[entry.slope][yl * tile_size + xl];
+        return height;
+    }
+
     static void clearTilePointers()
     {
         std::fill(_tiles.begin(), _tiles.end(), InvalidTile);
@@ -271,6 +387,7 @@ namespace OpenLoco::Map::TileManager
         }
 
         _elementsEnd = el;
+        invalidateCaches();
     }
 
     // 0x0046148F
@@ -282,7 +399,7 @@ namespace OpenLoco::Map::TileManager
         {
             // Allocate a temporary buffer and tighly pack all the tile elements in the map
             std::vector<TileElement> tempBuffer;
-            tempBuffer.resize(maxElements * sizeof(TileElement));
+            tempBuffer.resize(getElements().size());
 
             size_t numElements = 0;
             for (tile_coord_t y = 0; y < map_rows; y++)
@@ -312,11 +429,43 @@ namespace OpenLoco::Map::TileManager
         }
         catch (const std::bad_alloc&)
         {
-            exitWithError(4370, StringIds::null);
+            exitWithError(StringIds::unable_to_allocate_enough_memory, StringIds::null);
             return;
         }
     }
 
+    static bool hasFreeElements()
+    {
+        return getElementsEnd() <= _elements + maxElements - minFreeElements;
+    }
+
+    // 0x004613F0
+    static void defragmentTilePeriodic()
+    {
+        call(0x004613F0);
+    }
+
+    // 0x00461393
+    bool checkFreeElementsAndReorganise()
+    {
+        if (hasFreeElements())
+            return true;
+
+        for (auto i = 0; i < 1000; i++)
+        {
+            defragmentTilePeriodic();
+        }
+        if (hasFreeElements())
+            return true;
+
+        reorganise();
+        if (hasFreeElements())
+            return true;
+
+        GameCommands::setErrorText(StringIds::landscape_data_area_full);
+        return false;
+    }
+
     // 0x0045F1A7
     Pos2 screenGetMapXY(int16_t x, int16_t y)
     {
@@ -549,8 +698,26 @@ namespace OpenLoco::Map::TileManager
         _numAnimations = 0;
     }
 
-    // 0x004C5596
-    uint16_t countSurroundingWaterTiles(const Pos2& pos)
+    static uint16_t countTrees(const Tile& tile)
+    {
+        uint16_t trees = 0;
+        for (auto& element : tile)
+        {
+            // NB: vanilla was checking for trees above the surface element.
+            // This has been omitted from our implementation.
+            auto* tree = element.asTree();
+            if (tree == nullptr)
+                continue;
+
+            if (tree->isGhost())
+                continue;
+
+            trees++;
+        }
+        return trees;
+    }
+
+    static uint16_t scanSurroundingWaterTiles(const Pos2& pos)
     {
         // Search a 10x10 area centred at pos.
         // Initial tile position is the top left of the area.
@@ -575,8 +742,7 @@ namespace OpenLoco::Map::TileManager
         return surroundingWaterTiles;
     }
 
-    // 0x004BE048
-    uint16_t countSurroundingTrees(const Pos2& pos)
+    static uint16_t scanSurroundingTrees(const Pos2& pos)
     {
         // Search a 10x10 area centred at pos.
         // Initial tile position is the top left of the area.
@@ -591,28 +757,211 @@ namespace OpenLoco::Map::TileManager
                 if (!Map::validCoords(tilePos))
                     continue;
 
-                auto tile = get(tilePos);
-                for (auto& element : tile)
-                {
-                    // NB: vanilla was checking for trees above the surface element.
-                    // This has been omitted from our implementation.
-                    auto* tree = element.asTree();
-                    if (tree == nullptr)
-                        continue;
+                surroundingTrees += countTrees(get(tilePos));
+            }
+        }
 
-                    if (tree->isGhost())
-                        continue;
+        return surroundingTrees;
+    }
+
+    // Trees and water tiles on each tile, and the totals of the 11x11 area centred at each tile. The totals are
+    // updated tile by tile as the original game invalidates tiles it has changed, and only rebuilt when the
+    // whole map has been replaced.
+    struct NeighbourhoodCounts
+    {
+        uint16_t trees;
+        uint16_t water;
+    };
+
+    constexpr coord_t neighbourhoodRadius = 5;
+
+    static std::vector<NeighbourhoodCounts> _tileCounts;
+    static std::vector<NeighbourhoodCounts> _areaCounts;
+    static std::vector<uint8_t> _tileCountsStale;
+    static std::vector<TilePos2> _staleTiles;
+    static bool _neighbourhoodCountsValid = false;
 
-                    surroundingTrees++;
+    static NeighbourhoodCounts readNeighbourhoodCounts(const TilePos2& pos)
+    {
+        auto tile = get(pos);
+        auto* surface = tile.surface();
+        return { countTrees(tile), static_cast<uint16_t>((surface != nullptr && surface->water() > 0) ? 1 : 0) };
+    }
+
+    static void rebuildNeighbourhoodCounts()
+    {
+        _tileCounts.resize(map_size);
+        for (coord_t y = 0; y < map_rows; y++)
+        {
+            for (coord_t x = 0; x < map_columns; x++)
+            {
+                _tileCounts[y * map_columns + x] = readNeighbourhoodCounts(TilePos2(x, y));
+            }
+        }
+
+        // Summed area table of the tile counts, entry (x, y) holds the totals of all tiles above and to the left of (x, y)
+        constexpr coord_t sumsPitch = map_columns + 1;
+        std::vector<std::array<uint32_t, 2>> sums(sumsPitch * (map_rows + 1), { 0, 0 });
+        for (coord_t y = 0; y < map_rows; y++)
+        {
+            uint32_t rowTrees = 0;
+            uint32_t rowWater = 0;
+            for (coord_t x = 0; x < map_columns; x++)
+            {
+                rowTrees += _tileCounts[y * map_columns + x].trees;
+                rowWater += _tileCounts[y * map_columns + x].water;
+                const auto& above = sums[y * sumsPitch + x + 1];
+                sums[(y + 1) * sumsPitch + x + 1] = { above[0] + rowTrees, above[1] + rowWater };
+            }
+        }
+
+        _areaCounts.resize(map_size);
+        for (coord_t y = 0; y < map_rows; y++)
+        {
+            const coord_t top = std::max<coord_t>(y - neighbourhoodRadius, 0);
+            const coord_t bottom = std::min<coord_t>(y + neighbourhoodRadius + 1, map_rows);
+            for (coord_t x = 0; x < map_columns; x++)
+            {
+                const coord_t left = std::max<coord_t>(x - neighbourhoodRadius, 0);
+                const coord_t right = std::min<coord_t>(x + neighbourhoodRadius + 1, map_columns);
+                const auto& topLeft = sums[top * sumsPitch + left];
+                const auto& topRight = sums[top * sumsPitch + right];
+                const auto& bottomLeft = sums[bottom * sumsPitch + left];
+                const auto& bottomRight = sums[bottom * sumsPitch + right];
+                auto& area = _areaCounts[y * map_columns + x];
+                area.trees = static_cast<uint16_t>(bottomRight[0] - bottomLeft[0] - topRight[0] + topLeft[0]);
+                area.water = static_cast<uint16_t>(bottomRight[1] - bottomLeft[1] - topRight[1] + topLeft[1]);
+            }
+        }
+
+        _tileCountsStale.assign(map_size, 0);
+        _staleTiles.clear();
+        _neighbourhoodCountsValid = true;
+    }
+
+    // Re-counts the tiles changed since the last query and adds the differences to every area they are part of
+    static void updateStaleNeighbourhoodCounts()
+    {
+        for (const auto& pos : _staleTiles)
+        {
+            const auto index = pos.y * map_columns + pos.x;
+            _tileCountsStale[index] = 0;
+
+            const auto counts = readNeighbourhoodCounts(pos);
+            const int32_t treesDelta = counts.trees - _tileCounts[index].trees;
+            const int32_t waterDelta = counts.water - _tileCounts[index].water;
+            if (treesDelta == 0 && waterDelta == 0)
+                continue;
+
+            _tileCounts[index] = counts;
+            const coord_t top = std::max<coord_t>(pos.y - neighbourhoodRadius, 0);
+            const coord_t bottom = std::min<coord_t>(pos.y + neighbourhoodRadius, map_rows - 1);
+            const coord_t left = std::max<coord_t>(pos.x - neighbourhoodRadius, 0);
+            const coord_t right = std::min<coord_t>(pos.x + neighbourhoodRadius, map_columns - 1);
+            for (coord_t y = top; y <= bottom; y++)
+            {
+                for (coord_t x = left; x <= right; x++)
+                {
+                    auto& area = _areaCounts[y * map_columns + x];
+                    area.trees = static_cast<uint16_t>(area.trees + treesDelta);
+                    area.water = static_cast<uint16_t>(area.water + waterDelta);
                 }
             }
         }
+        _staleTiles.clear();
+    }
 
-        return surroundingTrees;
+    // Tiles are re-counted on the next query rather than now, as tiles are often invalidated before they are changed
+    void invalidateNeighbourhoodCounts(const Pos2& pos)
+    {
+        if (!_neighbourhoodCountsValid)
+            return;
+
+        const auto tilePos = TilePos2(pos);
+        if (!Map::validCoords(tilePos))
+            return;
+
+        auto& stale = _tileCountsStale[tilePos.y * map_columns + tilePos.x];
+        if (stale == 0)
+        {
+            stale = 1;
+            _staleTiles.push_back(tilePos);
+        }
+    }
+
+    // Returns false if the centre is off the map, those areas are not kept and have to be scanned
+    static bool getNeighbourhoodCounts(const Pos2& pos, NeighbourhoodCounts& counts)
+    {
+        const auto centre = TilePos2(pos);
+        if (!Map::validCoords(centre))
+            return false;
+
+        if (!_neighbourhoodCountsValid)
+        {
+            rebuildNeighbourhoodCounts();
+        }
+        updateStaleNeighbourhoodCounts();
+
+        counts = _areaCounts[centre.y * map_columns + centre.x];
+        return true;
+    }
+
+    // 0x004C5596
+    uint16_t countSurroundingWaterTiles(const Pos2& pos)
+    {
+        NeighbourhoodCounts counts;
+        if (!getNeighbourhoodCounts(pos, counts))
+        {
+            return scanSurroundingWaterTiles(pos);
+        }
+
+#if DEBUG
+        assert(counts.water == scanSurroundingWaterTiles(pos));
+#endif
+        return counts.water;
+    }
+
+    // 0x004BE048
+    uint16_t countSurroundingTrees(const Pos2& pos)
+    {
+        NeighbourhoodCounts counts;
+        if (!getNeighbourhoodCounts(pos, counts))
+        {
+            return scanSurroundingTrees(pos);
+        }
+
+#if DEBUG
+        assert(counts.trees == scanSurroundingTrees(pos));
+#endif
+        return counts.trees;
+    }
+
+    // Must be called whenever tile elements have been replaced or modified without invalidating the tiles
+    void invalidateCaches()
+    {
+        invalidateHeightCache();
+        _neighbourhoodCountsValid = false;
     }
 
     void registerHooks()
     {
+        registerHook(
+            0x00467297,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                auto height = getHeight({ regs.ax, regs.cx });
+                regs.edx = (static_cast<uint16_t>(height.waterHeight) << 16) | static_cast<uint16_t>(height.landHeight);
+                return 0;
+            });
+
+        registerHook(
+            0x00461393,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                const auto hasSpace = checkFreeElementsAndReorganise();
+                regs = backup;
+                return hasSpace ? 0 : X86_FLAG_CARRY;
+            });
+
         registerHook(
             0x004612A6,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
@@ -620,6 +969,15 @@ namespace OpenLoco::Map::TileManager
                 return 0;
             });
 
+        registerHook(
+            0x00461348,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                updateTilePointers();
+                regs = backup;
+                return 0;
+            });
+
         // This hook can be removed once sub_4599B3 has been implemented
         registerHook(
             0x004BE048,
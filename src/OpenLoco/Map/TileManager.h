@@ -7,8 +7,11 @@
 
 namespace OpenLoco::Map::TileManager
 {
-    constexpr size_t maxElements = 0x6C000;
+    // The original game has room for 0x6C000 elements, saves with more are only written in the OpenLoco format
+    constexpr size_t maxElementsVanilla = 0x6C000;
+    constexpr size_t maxElements = maxElementsVanilla * 4;
 
+    void allocateElements();
     void initialise();
     stdx::span<TileElement> getElements();
     TileElement* getElementsEnd();
@@ -16,10 +19,15 @@ namespace OpenLoco::Map::TileManager
     Tile get(TilePos2 pos);
     Tile get(Pos2 pos);
     Tile get(coord_t x, coord_t y);
+    stdx::span<TileElement> getElementStorage();
     void setElements(stdx::span<TileElement> elements);
     TileHeight getHeight(const Pos2& pos);
+    void invalidateHeightCache();
+    void invalidateCaches();
+    void invalidateNeighbourhoodCounts(const Pos2& pos);
     void updateTilePointers();
     void reorganise();
+    bool checkFreeElementsAndReorganise();
     Pos2 screenGetMapXY(int16_t x, int16_t y);
     uint16_t setMapSelectionTiles(int16_t x, int16_t y);
     Pos3 screenPosToMapPos(int16_t x, int16_t y);
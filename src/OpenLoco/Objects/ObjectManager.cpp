@@ -1,4 +1,5 @@
 #include "ObjectManager.h"
+#include "../Console.h"
 #include "../Core/FileSystem.hpp"
 #include "../Graphics/Colour.h"
 #include "../Graphics/Gfx.h"
@@ -8,7 +9,15 @@
 #include "../S5/SawyerStream.h"
 #include "../Ui/ProgressBar.h"
 #include "../Utility/Numeric.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <iterator>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 using namespace OpenLoco::Interop;
@@ -391,19 +400,119 @@ namespace OpenLoco::ObjectManager
         return *_installedObjectCount;
     }
 
-    std::vector<std::pair<uint32_t, ObjectIndexEntry>> getAvailableObjects(ObjectType type)
+    // Checksum of the object folder the index was built from, see 0x00470F3C
+    static loco_global<uint32_t[3], 0x0112A138> _installedObjectsChecksum;
+
+    struct AvailableObjects
     {
-        auto ptr = (std::byte*)_installedObjectList;
-        std::vector<std::pair<uint32_t, ObjectIndexEntry>> list;
+        std::vector<std::pair<uint32_t, ObjectIndexEntry>> objects;
+        std::vector<std::string> names; // Lower case, for searching
+        std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams;
+    };
+
+    // The installed objects of each type, rebuilt whenever the original code reloads the index
+    static std::array<AvailableObjects, maxObjectTypes> _availableObjects;
+    static std::byte* _availableObjectsList = nullptr;
+    static uint32_t _availableObjectsCount = 0;
+    static std::array<uint32_t, 3> _availableObjectsChecksum{};
+
+    static std::string toSearchKey(std::string_view text)
+    {
+        std::string result(text);
+        for (auto& c : result)
+        {
+            c = static_cast<char>(std::tolower(static_cast<uint8_t>(c)));
+        }
+        return result;
+    }
+
+    static uint32_t getTrigram(const std::string& text, size_t index)
+    {
+        return static_cast<uint8_t>(text[index]) | (static_cast<uint8_t>(text[index + 1]) << 8) | (static_cast<uint8_t>(text[index + 2]) << 16);
+    }
+
+    static void updateAvailableObjects()
+    {
+        std::array<uint32_t, 3> checksum;
+        std::copy(std::begin(_installedObjectsChecksum), std::end(_installedObjectsChecksum), checksum.begin());
+        if (_availableObjectsList == *_installedObjectList && _availableObjectsCount == *_installedObjectCount && _availableObjectsChecksum == checksum)
+        {
+            return;
+        }
+
+        _availableObjectsList = _installedObjectList;
+        _availableObjectsCount = _installedObjectCount;
+        _availableObjectsChecksum = checksum;
+        for (auto& available : _availableObjects)
+        {
+            available = {};
+        }
 
+        auto ptr = (std::byte*)_installedObjectList;
         for (uint32_t i = 0; i < _installedObjectCount; i++)
         {
             auto entry = ObjectIndexEntry::read(&ptr);
-            if (entry._header->getType() == type)
-                list.emplace_back(std::pair<uint32_t, ObjectIndexEntry>(i, entry));
+            const auto type = static_cast<size_t>(entry._header->getType());
+            if (type >= maxObjectTypes)
+                continue;
+
+            auto& available = _availableObjects[type];
+            const auto position = static_cast<uint32_t>(available.objects.size());
+            available.objects.emplace_back(i, entry);
+            auto& name = available.names.emplace_back(toSearchKey(entry._name));
+            for (size_t j = 0; j + 3 <= name.size(); j++)
+            {
+                auto& positions = available.trigrams[getTrigram(name, j)];
+                if (positions.empty() || positions.back() != position)
+                {
+                    positions.push_back(position);
+                }
+            }
         }
+    }
 
-        return list;
+    const std::vector<std::pair<uint32_t, ObjectIndexEntry>>& getAvailableObjects(ObjectType type)
+    {
+        updateAvailableObjects();
+        return _availableObjects[static_cast<size_t>(type)].objects;
+    }
+
+    // Returns the positions in getAvailableObjects(type) of the objects with the text in their name, ignoring case
+    std::vector<uint32_t> searchAvailableObjects(ObjectType type, std::string_view text)
+    {
+        updateAvailableObjects();
+        const auto& available = _availableObjects[static_cast<size_t>(type)];
+        const auto query = toSearchKey(text);
+
+        std::vector<uint32_t> result;
+        if (query.size() < 3)
+        {
+            for (uint32_t i = 0; i < available.names.size(); i++)
+            {
+                if (available.names[i].find(query) != std::string::npos)
+                    result.push_back(i);
+            }
+            return result;
+        }
+
+        // Only check the names that contain the rarest trigram of the query
+        const std::vector<uint32_t>* candidates = nullptr;
+        for (size_t i = 0; i + 3 <= query.size(); i++)
+        {
+            auto it = available.trigrams.find(getTrigram(query, i));
+            if (it == available.trigrams.end())
+                return result;
+
+            if (candidates == nullptr || it->second.size() < candidates->size())
+                candidates = &it->second;
+        }
+
+        for (auto position : *candidates)
+        {
+            if (available.names[position].find(query) != std::string::npos)
+                result.push_back(position);
+        }
+        return result;
     }
 
     // 0x00471B95
@@ -515,15 +624,6 @@ namespace OpenLoco::ObjectManager
         throw std::runtime_error("Object not loaded at this index");
     }
 
-    // 0x00471BC5
-    static bool load(const ObjectHeader& header, LoadedObjectId id)
-    {
-        registers regs;
-        regs.ebp = reinterpret_cast<uint32_t>(&header);
-        regs.ecx = static_cast<int32_t>(id);
-        return (call(0x00471BC5, regs) & X86_FLAG_CARRY) == 0;
-    }
-
     static LoadedObjectId getObjectId(LoadedObjectIndex index)
     {
         size_t objectType = 0;
@@ -540,29 +640,6 @@ namespace OpenLoco::ObjectManager
         return std::numeric_limits<LoadedObjectId>::max();
     }
 
-    LoadObjectsResult loadAll(stdx::span<ObjectHeader> objects)
-    {
-        LoadObjectsResult result;
-        result.success = true;
-
-        unloadAll();
-
-        LoadedObjectIndex index = 0;
-        for (const auto& header : objects)
-        {
-            auto id = getObjectId(index);
-            if (!load(header, id))
-            {
-                result.success = false;
-                result.problemObject = header;
-                unloadAll();
-                break;
-            }
-            index++;
-        }
-        return result;
-    }
-
     // 0x00472754
     static uint32_t computeChecksum(stdx::span<const uint8_t> data, uint32_t seed)
     {
@@ -593,6 +670,258 @@ namespace OpenLoco::ObjectManager
         return checksum == object.checksum;
     }
 
+    static loco_global<char[257], 0x0050B635> _pathObjects;
+    static loco_global<uint8_t, 0x0050D161> _50D161;
+
+    // Custom objects must match exactly, original objects only need the same type and name
+    static bool isMatchingObject(const ObjectHeader& candidate, const ObjectHeader& header)
+    {
+        if (candidate.isCustom())
+        {
+            return candidate == header;
+        }
+        return candidate.getType() == header.getType() && candidate.getName() == header.getName();
+    }
+
+    static std::string getObjectKey(const ObjectHeader& header)
+    {
+        std::string key(header.getName());
+        key.push_back(static_cast<char>(header.getType()));
+        return key;
+    }
+
+    // An object read, decoded and checksummed off the main thread, ready to be installed
+    struct PreloadedObject
+    {
+        ObjectHeader header; // As read from the file
+        uint8_t* data = nullptr;
+        size_t dataSize = 0;
+        bool checksumValid = false;
+        std::chrono::steady_clock::duration readTime{};
+        std::chrono::steady_clock::duration installTime{};
+    };
+
+    // The part of 0x00471BC5 that doesn't touch the original game's state, so it can run on any thread
+    static void preloadObject(const ObjectHeader& header, const std::vector<const char*>& filenames, PreloadedObject& result)
+    {
+        const auto startTime = std::chrono::steady_clock::now();
+        for (auto* filename : filenames)
+        {
+            try
+            {
+                auto path = fs::u8path(_pathObjects.get());
+                path.replace_filename(fs::u8path(filename));
+
+                SawyerStreamReader stream(path);
+                ObjectHeader fileHeader;
+                stream.read(&fileHeader, sizeof(fileHeader));
+                if (!isMatchingObject(fileHeader, header))
+                {
+                    continue;
+                }
+
+                auto data = stream.readChunk();
+
+                // Allocated with malloc as the object is freed by the original game when unloaded
+                auto* objectData = static_cast<uint8_t*>(malloc(data.size()));
+                if (objectData == nullptr)
+                {
+                    break;
+                }
+                std::copy(std::begin(data), std::end(data), objectData);
+
+                result.header = fileHeader;
+                result.data = objectData;
+                result.dataSize = data.size();
+                result.checksumValid = computeObjectChecksum(fileHeader, data);
+                break;
+            }
+            catch (const std::exception&)
+            {
+                // Unreadable file, try the next one with the same name
+            }
+        }
+        result.readTime = std::chrono::steady_clock::now() - startTime;
+    }
+
+    // Reads, decodes and checksums all the objects on a pool of threads
+    static std::vector<PreloadedObject> preloadObjects(stdx::span<ObjectHeader> objects)
+    {
+        // Object files that could hold each object, in the order the original game searches them
+        std::unordered_map<std::string, std::vector<std::pair<const ObjectHeader*, const char*>>> installed;
+        auto ptr = (std::byte*)_installedObjectList;
+        for (uint32_t i = 0; i < _installedObjectCount; i++)
+        {
+            auto entry = ObjectIndexEntry::read(&ptr);
+            installed[getObjectKey(*entry._header)].emplace_back(entry._header, entry._filename);
+        }
+
+        std::vector<std::vector<const char*>> filenames(objects.size());
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            const auto& header = objects[i];
+            if (header.isEmpty())
+            {
+                continue;
+            }
+
+            auto it = installed.find(getObjectKey(header));
+            if (it == installed.end())
+            {
+                continue;
+            }
+            for (auto [entryHeader, filename] : it->second)
+            {
+                if (isMatchingObject(*entryHeader, header))
+                {
+                    filenames[i].push_back(filename);
+                }
+            }
+        }
+
+        std::vector<PreloadedObject> preloaded(objects.size());
+        std::atomic<size_t> next{ 0 };
+        auto worker = [&]() {
+            for (auto i = next++; i < objects.size(); i = next++)
+            {
+                if (!filenames[i].empty())
+                {
+                    preloadObject(objects[i], filenames[i], preloaded[i]);
+                }
+            }
+        };
+
+        const auto numThreads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < numThreads; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return preloaded;
+    }
+
+    // The part of 0x00471BC5 that installs the object into the original game's object slots
+    static bool installPreloadedObject(PreloadedObject& preloaded, LoadedObjectId id)
+    {
+        if (preloaded.data == nullptr || !preloaded.checksumValid)
+        {
+            return false;
+        }
+
+        auto* obj = reinterpret_cast<Object*>(preloaded.data);
+        if (!callObjectFunction(preloaded.header, *obj, ObjectProcedure::validate))
+        {
+            return false;
+        }
+
+        if (_totalNumImages >= 266266)
+        {
+            return false;
+        }
+
+        const auto type = preloaded.header.getType();
+        getRepositoryItem(type).objects[id] = obj;
+        getRepositoryItem(type).object_entry_extendeds[id] = ObjectEntry2(preloaded.header, preloaded.dataSize);
+        preloaded.data = nullptr;
+
+        if (_50D161 != 0)
+        {
+            registers regs;
+            regs.al = static_cast<uint8_t>(ObjectProcedure::load);
+            regs.esi = reinterpret_cast<uint32_t>(obj);
+            regs.ebx = id;
+            regs.ecx = static_cast<uint32_t>(type);
+            call(*((const uintptr_t*)0x004FE1C8 + static_cast<size_t>(type)), regs);
+        }
+        return true;
+    }
+
+    static void logLoadProfile(stdx::span<ObjectHeader> objects, const std::vector<PreloadedObject>& preloaded, std::chrono::steady_clock::duration totalTime)
+    {
+        if (!Console::isEnabled(Console::Category::general, Console::Level::verbose))
+        {
+            return;
+        }
+
+        auto toMilliseconds = [](std::chrono::steady_clock::duration duration) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(duration).count() / 1000.0;
+        };
+
+        std::vector<size_t> order;
+        for (size_t i = 0; i < objects.size(); i++)
+        {
+            if (!objects[i].isEmpty())
+            {
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return preloaded[a].readTime + preloaded[a].installTime > preloaded[b].readTime + preloaded[b].installTime;
+        });
+
+        Console::logVerbose("Loaded %zu objects in %.1f ms, slowest:", order.size(), toMilliseconds(totalTime));
+        for (size_t i = 0; i < std::min<size_t>(order.size(), 10); i++)
+        {
+            const auto& object = preloaded[order[i]];
+            Console::logVerbose(
+                "  %.8s read %6.2f ms, install %6.2f ms, %zu bytes",
+                objects[order[i]].name,
+                toMilliseconds(object.readTime),
+                toMilliseconds(object.installTime),
+                object.dataSize);
+        }
+    }
+
+    // Files are read and decoded in parallel, then installed in order on the main thread
+    LoadObjectsResult loadAll(stdx::span<ObjectHeader> objects)
+    {
+        LoadObjectsResult result;
+        result.success = true;
+
+        unloadAll();
+
+        const auto startTime = std::chrono::steady_clock::now();
+        auto preloaded = preloadObjects(objects);
+
+        for (size_t index = 0; index < objects.size(); index++)
+        {
+            const auto& header = objects[index];
+            if (header.isEmpty())
+            {
+                continue;
+            }
+
+            const auto installStart = std::chrono::steady_clock::now();
+            const bool installed = installPreloadedObject(preloaded[index], getObjectId(index));
+            preloaded[index].installTime = std::chrono::steady_clock::now() - installStart;
+            if (!installed)
+            {
+                result.success = false;
+                result.problemObject = header;
+                break;
+            }
+        }
+
+        for (auto& object : preloaded)
+        {
+            free(object.data);
+        }
+
+        if (!result.success)
+        {
+            unloadAll();
+            return result;
+        }
+
+        logLoadProfile(objects, preloaded, std::chrono::steady_clock::now() - startTime);
+        return result;
+    }
+
     static bool partialLoad(const ObjectHeader& header, stdx::span<uint8_t> objectData)
     {
         auto type = header.getType();
@@ -714,7 +1043,6 @@ namespace OpenLoco::ObjectManager
     // is possible and if not permutates the name until it is valid.
     static fs::path findObjectPath(std::string& filename)
     {
-        loco_global<char[257], 0x0050B635> _pathObjects;
         auto objPath = fs::path(_pathObjects.get());
 
         bool permutateName = false;
@@ -764,7 +1092,7 @@ namespace OpenLoco::ObjectManager
 
     static bool isObjectInstalled(const ObjectHeader& objectHeader)
     {
-        const auto objects = getAvailableObjects(objectHeader.getType());
+        const auto& objects = getAvailableObjects(objectHeader.getType());
         auto res = std::find_if(std::begin(objects), std::end(objects), [&objectHeader](auto& obj) { return *obj.second._header == objectHeader; });
         return res != std::end(objects);
     }
@@ -856,7 +1184,7 @@ namespace OpenLoco::ObjectManager
     // 0x00472AFE
     ObjIndexPair getActiveObject(ObjectType objectType, uint8_t* edi)
     {
-        const auto objects = getAvailableObjects(objectType);
+        const auto& objects = getAvailableObjects(objectType);
 
         for (auto [index, object] : objects)
         {
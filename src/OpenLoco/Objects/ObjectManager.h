@@ -290,7 +290,8 @@ namespace OpenLoco::ObjectManager
     };
 
     uint32_t getNumInstalledObjects();
-    std::vector<std::pair<uint32_t, ObjectIndexEntry>> getAvailableObjects(ObjectType type);
+    const std::vector<std::pair<uint32_t, ObjectIndexEntry>>& getAvailableObjects(ObjectType type);
+    std::vector<uint32_t> searchAvailableObjects(ObjectType type, std::string_view text);
     void freeScenarioText();
     void getScenarioText(ObjectHeader& object);
     std::optional<LoadedObjectIndex> findIndex(const ObjectHeader& header);
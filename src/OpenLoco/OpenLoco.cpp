@@ -35,6 +35,7 @@
 #include "GameException.hpp"
 #include "Graphics/Colour.h"
 #include "Graphics/Gfx.h"
+#include "Graphics/TextLayout.h"
 #include "Gui.h"
 #include "IndustryManager.h"
 #include "Input.h"
@@ -43,6 +44,7 @@
 #include "Localisation/LanguageFiles.h"
 #include "Localisation/Languages.h"
 #include "Localisation/StringIds.h"
+#include "Map/TileManager.h"
 #include "MultiPlayer.h"
 #include "Objects/ObjectManager.h"
 #include "OpenLoco.h"
@@ -59,6 +61,7 @@
 #include "Ui/ProgressBar.h"
 #include "Ui/WindowManager.h"
 #include "Utility/Numeric.hpp"
+#include "Utility/TaskGraph.hpp"
 #include "ViewportManager.h"
 
 #pragma warning(disable : 4611) // interaction between '_setjmp' and C++ object destruction is non - portable
@@ -106,6 +109,7 @@ namespace OpenLoco
     static loco_global<char[256], 0x011368A0> _11368A0;
 
     static int32_t _monthsSinceLastAutosave;
+    static bool _startupProfile = false;
 
     static void autosaveReset();
     static void tickLogic(int32_t count);
@@ -327,6 +331,8 @@ namespace OpenLoco
     // 0x004BE621
     static void exitWithError(string_id eax, string_id ebx)
     {
+        // The original exit path does not return to us, write out the log while we still can
+        Console::flush();
         registers regs;
         regs.eax = eax;
         regs.ebx = ebx;
@@ -337,6 +343,7 @@ namespace OpenLoco
     void exitWithError(string_id message, uint32_t errorCode)
     {
         // Saves the error code for later writing to error log 1.TMP.
+        Console::flush();
         registers regs;
         regs.eax = errorCode;
         regs.bx = message;
@@ -351,6 +358,16 @@ namespace OpenLoco
         Ui::disposeCursors();
         Ui::disposeInput();
         Localisation::unloadLanguageFile();
+        CompanyManager::logAiThinkStats();
+
+        if (Interop::isProfilingEnabled())
+        {
+            auto profileDirectory = Environment::getPathNoWarning(Environment::path_id::openloco_yml).parent_path();
+            auto reportPath = (profileDirectory / "interop_profile.txt").u8string();
+            auto foldedPath = (profileDirectory / "interop_profile.folded").u8string();
+            Interop::writeProfile(reportPath.c_str(), foldedPath.c_str());
+            printf("Interop profile written to '%s'\n", reportPath.c_str());
+        }
 
         auto tempFilePath = Environment::getPathNoWarning(Environment::path_id::_1tmp);
         if (fs::exists(tempFilePath))
@@ -360,6 +377,7 @@ namespace OpenLoco
             fs::remove(tempFilePath);
         }
         crashClose(_exHandler);
+        Console::flush();
 
         // SDL_Quit();
         exit(0);
@@ -379,6 +397,32 @@ namespace OpenLoco
         // with g1 alone and some objects?
     }
 
+    void enableStartupProfile()
+    {
+        _startupProfile = true;
+    }
+
+    static void printStartupProfile(const Utility::TaskGraph& startup)
+    {
+        using namespace std::chrono;
+
+        auto toMilliseconds = [](Utility::TaskGraph::Clock::duration duration) {
+            return duration_cast<microseconds>(duration).count() / 1000.0;
+        };
+
+        Console::log("Startup profile:");
+        for (const auto& task : startup.tasks())
+        {
+            Console::log(
+                "  %-30s %-7s start %8.1f ms, took %8.1f ms",
+                task.name,
+                task.mainThread ? "main" : "worker",
+                toMilliseconds(task.startTime - startup.startTime()),
+                toMilliseconds(task.endTime - task.startTime));
+        }
+        Console::log("  Total %.1f ms", toMilliseconds(startup.endTime() - startup.startTime()));
+    }
+
     // 0x004C57C0
     void initialiseViewports()
     {
@@ -412,28 +456,55 @@ namespace OpenLoco
         std::srand(std::time(0));
         addr<0x0050C18C, int32_t>() = addr<0x00525348, int32_t>();
         call(0x004078BE);
-        call(0x004BF476);
+        Map::TileManager::allocateElements();
         Environment::resolvePaths();
-        Localisation::enumerateLanguages();
-        Localisation::loadLanguageFile();
-        Ui::ProgressBar::begin(StringIds::loading);
-        Ui::ProgressBar::setProgress(30);
-        startupChecks();
-        Ui::ProgressBar::setProgress(40);
-        call(0x004BE5DE);
-        Ui::ProgressBar::end();
-        Config::read();
-        ObjectManager::loadIndex();
-        ScenarioManager::loadIndex(0);
-        Ui::ProgressBar::begin(StringIds::loading);
-        Ui::ProgressBar::setProgress(60);
-        Gfx::loadG1();
-        Ui::ProgressBar::setProgress(220);
-        call(0x004949BC);
-        Ui::ProgressBar::setProgress(235);
-        Ui::ProgressBar::setProgress(250);
-        Ui::initialiseCursors();
-        Ui::ProgressBar::end();
+
+        // Loading languages and g1 only touches native state, so these run on worker threads. The original
+        // startup code is not thread safe and stays on the main thread in its original order.
+        Utility::TaskGraph startup;
+        auto languages = startup.add("Enumerate languages", false, []() { Localisation::enumerateLanguages(); });
+        auto language = startup.add("Load language", false, []() { Localisation::loadLanguageFile(); });
+        auto g1 = startup.add("Load g1", false, []() { Gfx::loadG1(); });
+        auto checks = startup.add(
+            "Startup checks", true, []() {
+                Ui::ProgressBar::begin(StringIds::loading);
+                Ui::ProgressBar::setProgress(30);
+                startupChecks();
+                Ui::ProgressBar::setProgress(40);
+                call(0x004BE5DE);
+                Ui::ProgressBar::end();
+            },
+            { language });
+        auto config = startup.add("Read config", true, []() { Config::read(); }, { checks });
+        auto objectIndex = startup.add("Load object index", true, []() { ObjectManager::loadIndex(); }, { config });
+        auto scenarioIndex = startup.add("Load scenario index", true, []() { ScenarioManager::loadIndex(0); }, { objectIndex });
+        auto waitForG1 = startup.add(
+            "Wait for g1", true, []() {
+                Ui::ProgressBar::begin(StringIds::loading);
+                Ui::ProgressBar::setProgress(60);
+            },
+            { scenarioIndex });
+        startup.add(
+            "Initialise fonts and cursors", true, []() {
+                Ui::ProgressBar::setProgress(220);
+                call(0x004949BC);
+                // Character widths may have changed
+                Gfx::invalidateTextLayoutCache();
+                Ui::ProgressBar::setProgress(235);
+                Ui::ProgressBar::setProgress(250);
+                Ui::initialiseCursors();
+                Ui::ProgressBar::end();
+            },
+            { waitForG1, g1, languages });
+        // The window manager does not exist yet so events are only pumped, a quit request stays queued
+        // until the main loop's first processMessages after initialisation.
+        startup.run([]() { Ui::pumpMessages(); });
+
+        if (_startupProfile)
+        {
+            printStartupProfile(startup);
+        }
+
         Ui::initialise();
         initialiseViewports();
         call(0x004284C8);
@@ -590,9 +661,13 @@ namespace OpenLoco
         static uint8_t spareStackMemory[2048];
         tickJumpESP = spareStackMemory + sizeof(spareStackMemory);
 
+        // The jump skips the end of any profiled calls that were in progress
+        const auto profileDepth = Interop::getProfileDepth();
+
         if (setjmp(tickJump))
         {
             // Premature end of current tick
+            Interop::unwindProfile(profileDepth);
             tickInterrupted();
             return;
         }
@@ -834,7 +909,10 @@ namespace OpenLoco
     // 0x0046ABCB
     static void tickLogic()
     {
+        Map::TileManager::invalidateHeightCache();
+        CompanyManager::invalidateVehicleCounts();
         _scenario_ticks++;
+        Console::setTick(_scenario_ticks);
         addr<0x00525F64, int32_t>()++;
         addr<0x00525FCC, uint32_t>() = _prng->srand_0();
         addr<0x00525FD0, uint32_t>() = _prng->srand_1();
@@ -905,10 +983,25 @@ namespace OpenLoco
                     // Sort them by name (which should correspond to date order)
                     std::sort(autosaveFiles.begin(), autosaveFiles.end());
 
-                    // Delete excess files
+                    // Keep the base saves of any delta saves that are kept
                     auto numToDelete = autosaveFiles.size() - amountToKeep;
+                    std::vector<fs::path> deltaBases;
+                    for (size_t i = numToDelete; i < autosaveFiles.size(); i++)
+                    {
+                        if (auto base = S5::getDeltaBase(autosaveFiles[i]))
+                        {
+                            deltaBases.push_back(*base);
+                        }
+                    }
+
+                    // Delete excess files
                     for (size_t i = 0; i < numToDelete; i++)
                     {
+                        if (std::find(deltaBases.begin(), deltaBases.end(), autosaveFiles[i]) != deltaBases.end())
+                        {
+                            continue;
+                        }
+
                         auto path8 = autosaveFiles[i].u8string();
                         std::printf("Deleting old autosave: %s\n", path8.c_str());
                         fs::remove(autosaveFiles[i]);
@@ -949,7 +1042,20 @@ namespace OpenLoco
 
             auto autosaveFullPath8 = autosaveFullPath.u8string();
             std::printf("Autosaving game to %s\n", autosaveFullPath8.c_str());
-            S5::save(autosaveFullPath, static_cast<S5::SaveFlags>(S5::SaveFlags::noWindowClose));
+            const auto& config = Config::getNew();
+            auto flags = static_cast<uint32_t>(S5::SaveFlags::noWindowClose);
+            if (config.autosave_lz_compression)
+            {
+                flags |= S5::SaveFlags::lzCompression;
+            }
+            if (config.autosave_deltas)
+            {
+                S5::saveDelta(autosaveFullPath, static_cast<S5::SaveFlags>(flags), config.autosave_rebase_interval);
+            }
+            else
+            {
+                S5::save(autosaveFullPath, static_cast<S5::SaveFlags>(flags));
+            }
         }
         catch (const std::exception& e)
         {
@@ -1176,6 +1282,17 @@ namespace OpenLoco
             const auto& cfg = Config::readNewConfig();
             Environment::resolvePaths();
 
+            if (cfg.verboseLogging)
+            {
+                Console::setLevel(Console::Level::verbose);
+            }
+            if (cfg.logToFile)
+            {
+                auto logPath = (Environment::getPathNoWarning(Environment::path_id::openloco_yml).parent_path() / "openloco.log").u8string();
+                Console::openLogFile(logPath.c_str());
+            }
+
+            Interop::setProfilingEnabled(cfg.profileInterop);
             registerHooks();
             if (sub_4054B9())
             {
@@ -1210,6 +1327,10 @@ __declspec(dllexport) int StartOpenLoco(HINSTANCE hInstance, HINSTANCE hPrevInst
 {
     OpenLoco::glpCmdLine = lpCmdLine;
     OpenLoco::ghInstance = hInstance;
+    if (lpCmdLine != nullptr && std::strstr(lpCmdLine, "--startup-profile") != nullptr)
+    {
+        OpenLoco::enableStartupProfile();
+    }
     OpenLoco::main();
     return 0;
 }
@@ -37,6 +37,7 @@ namespace OpenLoco
     void* hInstance();
     const char* lpCmdLine();
     void lpCmdLine(const char* path);
+    void enableStartupProfile();
     void resetScreenAge();
     uint16_t getScreenAge();
     uint16_t getScreenFlags();
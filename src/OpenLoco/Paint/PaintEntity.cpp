@@ -80,6 +80,7 @@ namespace OpenLoco::Paint
     void paintEntities(PaintSession& session, const Map::Pos2& loc)
     {
         paintEntitiesWithFilter(session, loc, [](const EntityBase*) { return true; });
+        paintParticles(session, loc);
     }
 
     static bool isEntityFlyingOrFloating(const EntityBase* entity)
@@ -1,15 +1,21 @@
 #include "PaintMiscEntity.h"
 #include "../CompanyManager.h"
+#include "../Config.h"
+#include "../Entities/ParticleManager.h"
 #include "../Graphics/Gfx.h"
 #include "../Graphics/ImageIds.h"
 #include "../Interop/Interop.hpp"
 #include "../Localisation/StringIds.h"
 #include "../Map/Tile.h"
+#include "../Objects/ObjectManager.h"
+#include "../Objects/SteamObject.h"
+#include "../Ui.h"
 #include "Paint.h"
 #include <cassert>
 #include <unordered_map>
 
 using namespace OpenLoco::Interop;
+using namespace OpenLoco::Ui::ViewportInteraction;
 
 namespace OpenLoco::Paint
 {
@@ -40,30 +46,35 @@ namespace OpenLoco::Paint
     };
     // clang-format on
 
-    // 0x00440331
-    static void paintExhaustEntity(PaintSession& session, Exhaust* exhaustEntity)
+    static void paintExhaust(PaintSession& session, uint8_t objectId, uint16_t frame, coord_t z)
     {
         Gfx::Context* context = session.getContext();
         if (context->zoom_level > 1)
         {
             return;
         }
-        SteamObject* steamObject = exhaustEntity->object();
+        SteamObject* steamObject = ObjectManager::get<SteamObject>(objectId & 0x7F);
 
-        uint8_t* edi = (exhaustEntity->object_id & 0x80) == 0 ? steamObject->var_16 : steamObject->var_1A;
-        uint32_t imageId = edi[2 * exhaustEntity->var_26];
+        uint8_t* edi = (objectId & 0x80) == 0 ? steamObject->var_16 : steamObject->var_1A;
+        uint32_t imageId = edi[2 * frame];
         imageId = imageId + steamObject->baseImageId + steamObject->var_0A;
 
         if ((steamObject->var_08 & (1 << 3)) == 0)
         {
-            session.addToPlotListAsParent(imageId, { 0, 0, exhaustEntity->position.z }, { 1, 1, 0 });
+            session.addToPlotListAsParent(imageId, { 0, 0, z }, { 1, 1, 0 });
         }
         else
         {
-            session.addToPlotListAsParent(imageId, { 0, 0, exhaustEntity->position.z }, { -12, -12, exhaustEntity->position.z }, { 24, 24, 0 });
+            session.addToPlotListAsParent(imageId, { 0, 0, z }, { -12, -12, z }, { 24, 24, 0 });
         }
     }
 
+    // 0x00440331
+    static void paintExhaustEntity(PaintSession& session, Exhaust* exhaustEntity)
+    {
+        paintExhaust(session, exhaustEntity->object_id, exhaustEntity->var_26, exhaustEntity->position.z);
+    }
+
     // 0x004403C5
     static void paintRedGreenCurrencyEntity(PaintSession& session, MoneyEffect* moneyEffect)
     {
@@ -275,8 +286,7 @@ namespace OpenLoco::Paint
         session.addToPlotListAsParent(imageId, { 0, 0, particle->position.z }, { 1, 1, 0 });
     }
 
-    // 0x004404E1
-    static void paintSmokeEntity(PaintSession& session, Smoke* particle)
+    static void paintSmoke(PaintSession& session, uint16_t frame, coord_t z)
     {
         Gfx::Context* context = session.getContext();
         if (context->zoom_level > 1)
@@ -299,9 +309,15 @@ namespace OpenLoco::Paint
             ImageIds::smoke_11
         };
 
-        assert(static_cast<size_t>(particle->frame / 256) < smokeImageIds.size());
-        uint32_t imageId = smokeImageIds.at(particle->frame / 256);
-        session.addToPlotListAsParent(imageId, { 0, 0, particle->position.z }, { 1, 1, 0 });
+        assert(static_cast<size_t>(frame / 256) < smokeImageIds.size());
+        uint32_t imageId = smokeImageIds.at(frame / 256);
+        session.addToPlotListAsParent(imageId, { 0, 0, z }, { 1, 1, 0 });
+    }
+
+    // 0x004404E1
+    static void paintSmokeEntity(PaintSession& session, Smoke* particle)
+    {
+        paintSmoke(session, particle->frame, particle->position.z);
     }
 
     // 0x00440325
@@ -364,4 +380,56 @@ namespace OpenLoco::Paint
             }
         }
     }
+
+    static bool isParticleVisible(PaintSession& session, const Map::Pos3& pos, int16_t halfWidth, int16_t above, int16_t below)
+    {
+        const auto* context = session.getContext();
+        const auto screenPos = Map::coordinate3dTo2d(pos.x, pos.y, pos.z, session.getRotation());
+        return screenPos.y - above <= context->y + context->height
+            && screenPos.y + below > context->y
+            && screenPos.x - halfWidth <= context->x + context->width
+            && screenPos.x + halfWidth > context->x;
+    }
+
+    // Exhaust and smoke particles are not entities, so they are painted straight from the particle pools
+    void paintParticles(PaintSession& session, const Map::Pos2& loc)
+    {
+        if (Config::get().vehicles_min_scale < session.getContext()->zoom_level)
+        {
+            return;
+        }
+
+        if (loc.x >= 0x4000 || loc.y >= 0x4000)
+        {
+            return;
+        }
+
+        session.setCurrentItem(nullptr);
+        session.setItemType(InteractionItem::noInteraction);
+
+        const auto& exhaust = ParticleManager::getExhaust();
+        for (auto i : ParticleManager::getExhaustOnTile(loc))
+        {
+            const Map::Pos3 pos = { exhaust.x[i], exhaust.y[i], exhaust.z[i] };
+            const auto* steamObject = ObjectManager::get<SteamObject>(exhaust.objectId[i] & 0x7F);
+            if (!isParticleVisible(session, pos, steamObject->var_05, steamObject->var_06, steamObject->var_07))
+            {
+                continue;
+            }
+            session.setEntityPosition(pos);
+            paintExhaust(session, exhaust.objectId[i], exhaust.frame[i], pos.z);
+        }
+
+        const auto& smoke = ParticleManager::getSmoke();
+        for (auto i : ParticleManager::getSmokeOnTile(loc))
+        {
+            const Map::Pos3 pos = { smoke.x[i], smoke.y[i], smoke.z[i] };
+            if (!isParticleVisible(session, pos, 44, 32, 34))
+            {
+                continue;
+            }
+            session.setEntityPosition(pos);
+            paintSmoke(session, smoke.frame[i], pos.z);
+        }
+    }
 }
@@ -14,4 +14,6 @@ namespace OpenLoco::Paint
      * @param base @<esi>
      */
     void paintMiscEntity(PaintSession& session, MiscBase* base);
+
+    void paintParticles(PaintSession& session, const Map::Pos2& loc);
 }
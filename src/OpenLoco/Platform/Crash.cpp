@@ -1,5 +1,6 @@
 #include "Crash.h"
 #if defined(USE_BREAKPAD)
+#include "../Console.h"
 #include "../OpenLoco.h"
 #include "../Utility/String.hpp"
 #include "Platform.h"
@@ -10,6 +11,8 @@ static bool onCrash(
     const wchar_t* dumpPath, const wchar_t* miniDumpId, void* context, EXCEPTION_POINTERS* exinfo,
     MDRawAssertionInfo* assertion, bool succeeded)
 {
+    OpenLoco::Console::flush();
+
     if (!succeeded)
     {
         constexpr const char* dumpFailedMessage = "Failed to create the dump. Please file an issue with OpenLoco on GitHub and "
@@ -4,9 +4,14 @@
 #include "../Interop/Interop.hpp"
 #include "../OpenLoco.h"
 #include "Platform.h"
+#include <cstring>
+#include <fcntl.h>
 #include <iostream>
 #include <pwd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <time.h>
+#include <unistd.h>
 
 #ifdef __linux__
 #include <linux/limits.h>
@@ -24,6 +29,13 @@ int main(int argc, const char** argv)
 {
     OpenLoco::Interop::loadSections();
     OpenLoco::lpCmdLine((char*)argv[0]);
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--startup-profile") == 0)
+        {
+            OpenLoco::enableStartupProfile();
+        }
+    }
     OpenLoco::main();
     return 0;
 }
@@ -121,6 +133,50 @@ namespace OpenLoco::platform
     {
         return false;
     }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    bool MappedFile::map(const fs::path& path)
+    {
+        unmap();
+
+        auto fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            return false;
+        }
+
+        struct stat fileStat;
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        auto data = mmap(nullptr, fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED)
+        {
+            return false;
+        }
+
+        _data = static_cast<std::byte*>(data);
+        _size = fileStat.st_size;
+        return true;
+    }
+
+    void MappedFile::unmap()
+    {
+        if (_data != nullptr)
+        {
+            munmap(_data, _size);
+            _data = nullptr;
+            _size = 0;
+        }
+    }
 }
 
 #endif
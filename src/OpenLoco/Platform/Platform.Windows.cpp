@@ -130,6 +130,60 @@ namespace OpenLoco::platform
         }
         return false;
     }
+
+    MappedFile::~MappedFile()
+    {
+        unmap();
+    }
+
+    bool MappedFile::map(const fs::path& path)
+    {
+        unmap();
+
+        auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        auto mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            return false;
+        }
+
+        auto data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+
+        _mapping = mapping;
+        _data = static_cast<std::byte*>(data);
+        _size = static_cast<size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::unmap()
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+            CloseHandle(_mapping);
+            _data = nullptr;
+            _mapping = nullptr;
+            _size = 0;
+        }
+    }
 }
 
 #endif
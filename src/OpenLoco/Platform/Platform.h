@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -16,4 +17,27 @@ namespace OpenLoco::platform
 #if defined(__APPLE__) && defined(__MACH__)
     fs::path GetBundlePath();
 #endif
+
+    // A file mapped into memory. Writes to the mapping are private to the process and never reach the file.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        bool map(const fs::path& path);
+        void unmap();
+
+        std::byte* data() const { return _data; }
+        size_t size() const { return _size; }
+
+    private:
+        std::byte* _data = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void* _mapping = nullptr;
+#endif
+    };
 }
@@ -4,6 +4,7 @@
 #include "../Audio/Audio.h"
 #include "../CompanyManager.h"
 #include "../Entities/EntityManager.h"
+#include "../Entities/ParticleManager.h"
 #include "../Game.h"
 #include "../GameException.hpp"
 #include "../Gui.h"
@@ -17,6 +18,7 @@
 #include "../TownManager.h"
 #include "../Ui/WindowManager.h"
 #include "../Utility/Exception.hpp"
+#include "../Utility/String.hpp"
 #include "../Vehicles/Orders.h"
 #include "../ViewportManager.h"
 #include "SawyerStream.h"
@@ -41,6 +43,32 @@ namespace OpenLoco::S5
     static loco_global<string_id, 0x0050C198> _loadErrorMessage;
 
     static bool save(const fs::path& path, const S5File& file, const std::vector<ObjectHeader>& packedObjects);
+    static bool saveDeltaOrBase(const fs::path& path, const S5File& file, const std::vector<ObjectHeader>& packedObjects, int32_t rebaseInterval);
+
+#pragma pack(push, 1)
+    // Follows the save details of a delta save, which only stores the pages of the game state and tile elements
+    // that differ from its base save. Each page chunk is a list of page indices, each followed by the page.
+    struct DeltaInfo
+    {
+        char baseFilename[256];
+        uint32_t pageSize;
+        uint32_t numTileElements;
+    };
+#pragma pack(pop)
+
+    constexpr uint32_t deltaPageSize = 4096;
+
+    // The last full save written by saveDelta, along with hashes of its pages
+    struct DeltaBase
+    {
+        fs::path path;
+        std::vector<ObjectHeader> requiredObjects;
+        std::vector<uint8_t> gameState;    // Copy of the base's bytes, pages are compared with these exactly
+        std::vector<uint8_t> tileElements;
+        int32_t numDeltas = 0;
+    };
+
+    static std::optional<DeltaBase> _deltaBase;
 
     Options& getOptions()
     {
@@ -79,6 +107,10 @@ namespace OpenLoco::S5
         {
             result.flags |= S5Flags::hasSaveDetails;
         }
+        if (flags & SaveFlags::lzCompression)
+        {
+            result.flags |= S5Flags::isLzCompressed;
+        }
 
         return result;
     }
@@ -265,6 +297,12 @@ namespace OpenLoco::S5
         file->tileElements.resize(tileElements.size());
         std::memcpy(file->tileElements.data(), tileElements.data(), tileElements.size_bytes());
         removeGhostElements(file->tileElements);
+
+        // The original game would overflow its element buffer loading these, so they are never written in its format
+        if (file->tileElements.size() > TileManager::maxElementsVanilla)
+        {
+            file->header.flags |= S5Flags::hasExtendedTileElements | S5Flags::isLzCompressed;
+        }
         return file;
     }
 
@@ -274,7 +312,8 @@ namespace OpenLoco::S5
     }
 
     // 0x00441C26
-    bool save(const fs::path& path, SaveFlags flags)
+    // A rebaseInterval above zero writes a delta against the last full save made this way, see saveDelta
+    static bool save(const fs::path& path, SaveFlags flags, int32_t rebaseInterval)
     {
         if (!(flags & SaveFlags::noWindowClose) && !(flags & SaveFlags::raw) && !(flags & SaveFlags::dump))
         {
@@ -302,7 +341,14 @@ namespace OpenLoco::S5
             }
 
             auto file = prepareSaveFile(flags, requiredObjects, packedObjects);
-            saveResult = save(path, *file, packedObjects);
+            if (rebaseInterval > 0)
+            {
+                saveResult = saveDeltaOrBase(path, *file, packedObjects, rebaseInterval);
+            }
+            else
+            {
+                saveResult = save(path, *file, packedObjects);
+            }
         }
 
         if (!(flags & SaveFlags::raw) && !(flags & SaveFlags::dump))
@@ -324,6 +370,111 @@ namespace OpenLoco::S5
         return false;
     }
 
+    bool save(const fs::path& path, SaveFlags flags)
+    {
+        return save(path, flags, 0);
+    }
+
+    // Writes only what changed since the last full save written by this function, which is repeated after every
+    // rebaseInterval deltas or when the objects change. The base save must be kept for the delta to load.
+    bool saveDelta(const fs::path& path, SaveFlags flags, int32_t rebaseInterval)
+    {
+        return save(path, flags, std::max(rebaseInterval, 1));
+    }
+
+    static std::vector<uint8_t> copyBytes(const void* data, size_t size)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(data);
+        return std::vector<uint8_t>(bytes, bytes + size);
+    }
+
+    static void writeChangedPages(SawyerStreamWriter& fs, SawyerEncoding encoding, const void* data, size_t size, const std::vector<uint8_t>& base)
+    {
+        auto bytes = reinterpret_cast<const uint8_t*>(data);
+        FastBuffer buffer;
+        for (uint32_t index = 0; index * deltaPageSize < size; index++)
+        {
+            const auto offset = index * deltaPageSize;
+            const auto length = std::min<size_t>(deltaPageSize, size - offset);
+            if (offset + length <= base.size() && std::memcmp(base.data() + offset, bytes + offset, length) == 0)
+            {
+                continue;
+            }
+
+            buffer.push_back(reinterpret_cast<const uint8_t*>(&index), sizeof(index));
+            buffer.push_back(bytes + offset, length);
+        }
+        fs.writeChunk(encoding, buffer.data(), buffer.size());
+    }
+
+    static bool canSaveDelta(const S5File& file, int32_t rebaseInterval)
+    {
+        if (!_deltaBase || _deltaBase->numDeltas >= rebaseInterval)
+            return false;
+        if (file.header.type != S5Type::savedGame || file.header.numPackedObjects != 0 || !(file.header.flags & S5Flags::hasSaveDetails))
+            return false;
+
+        std::error_code ec;
+        if (!fs::is_regular_file(_deltaBase->path, ec))
+            return false;
+
+        return std::memcmp(_deltaBase->requiredObjects.data(), file.requiredObjects, sizeof(file.requiredObjects)) == 0;
+    }
+
+    static bool saveDelta(const fs::path& path, const S5File& file)
+    {
+        try
+        {
+            auto header = file.header;
+            header.flags |= S5Flags::isDelta;
+
+            DeltaInfo info{};
+            Utility::strcpy_safe(info.baseFilename, _deltaBase->path.filename().u8string().c_str());
+            info.pageSize = deltaPageSize;
+            info.numTileElements = static_cast<uint32_t>(file.tileElements.size());
+
+            SawyerStreamWriter fs(path);
+            fs.writeChunk(SawyerEncoding::rotate, header);
+            fs.writeChunk(SawyerEncoding::rotate, *file.saveDetails);
+            fs.writeChunk(SawyerEncoding::rotate, info);
+            fs.writeChunk(SawyerEncoding::rotate, file.requiredObjects, sizeof(file.requiredObjects));
+            const auto encoding = (header.flags & S5Flags::isLzCompressed) ? SawyerEncoding::lz : SawyerEncoding::runLengthSingle;
+            writeChangedPages(fs, encoding, &file.gameState, sizeof(file.gameState), _deltaBase->gameState);
+            writeChangedPages(fs, encoding, file.tileElements.data(), file.tileElements.size() * sizeof(TileElement), _deltaBase->tileElements);
+            fs.writeChecksum();
+            fs.close();
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "Unable to save S5: %s\n", e.what());
+            return false;
+        }
+    }
+
+    static bool saveDeltaOrBase(const fs::path& path, const S5File& file, const std::vector<ObjectHeader>& packedObjects, int32_t rebaseInterval)
+    {
+        if (canSaveDelta(file, rebaseInterval))
+        {
+            if (!saveDelta(path, file))
+                return false;
+
+            _deltaBase->numDeltas++;
+            return true;
+        }
+
+        _deltaBase.reset();
+        if (!save(path, file, packedObjects))
+            return false;
+
+        auto& base = _deltaBase.emplace();
+        base.path = path;
+        base.requiredObjects.assign(std::begin(file.requiredObjects), std::end(file.requiredObjects));
+        base.gameState = copyBytes(&file.gameState, sizeof(file.gameState));
+        base.tileElements = copyBytes(file.tileElements.data(), file.tileElements.size() * sizeof(TileElement));
+        return true;
+    }
+
     static bool save(const fs::path& path, const S5File& file, const std::vector<ObjectHeader>& packedObjects)
     {
         try
@@ -344,15 +495,18 @@ namespace OpenLoco::S5
             }
             fs.writeChunk(SawyerEncoding::rotate, file.requiredObjects, sizeof(file.requiredObjects));
 
+            // The chunks before this stay in the original encodings so the browse and scenario lists can read them
+            const bool lz = file.header.flags & S5Flags::isLzCompressed;
+            const auto stateEncoding = lz ? SawyerEncoding::lz : SawyerEncoding::runLengthSingle;
             if (file.header.type == S5Type::scenario)
             {
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.rng, 0xB96C);
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.towns, 0x123480);
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState.animations, 0x79D80);
+                fs.writeChunk(stateEncoding, file.gameState.rng, 0xB96C);
+                fs.writeChunk(stateEncoding, file.gameState.towns, 0x123480);
+                fs.writeChunk(stateEncoding, file.gameState.animations, 0x79D80);
             }
             else
             {
-                fs.writeChunk(SawyerEncoding::runLengthSingle, file.gameState);
+                fs.writeChunk(stateEncoding, file.gameState);
             }
 
             if (file.header.flags & SaveFlags::raw)
@@ -361,7 +515,7 @@ namespace OpenLoco::S5
             }
             else
             {
-                fs.writeChunk(SawyerEncoding::runLengthMulti, file.tileElements.data(), file.tileElements.size() * sizeof(TileElement));
+                fs.writeChunk(lz ? SawyerEncoding::lz : SawyerEncoding::runLengthMulti, file.tileElements.data(), file.tileElements.size() * sizeof(TileElement));
             }
 
             fs.writeChecksum();
@@ -414,31 +568,35 @@ namespace OpenLoco::S5
     }
 
     // 0x00441FC9
-    static std::unique_ptr<S5File> load(const fs::path& path)
+    // Reads everything up to the game state, which is decoded straight into place once the objects are loaded
+    static Header readHeader(SawyerStreamReader& fs, stdx::span<ObjectHeader> requiredObjects, DeltaInfo& deltaInfo)
     {
-        SawyerStreamReader fs(path);
         if (!fs.validateChecksum())
         {
             throw std::runtime_error("Invalid checksum");
         }
 
-        auto file = std::make_unique<S5File>();
-
         // Read header
-        fs.readChunk(&file->header, sizeof(file->header));
+        Header header{};
+        fs.readChunk(&header, sizeof(header));
 
-        // Read saved details 0x00442087
-        if (file->header.flags & S5Flags::hasSaveDetails)
+        // Skip saved details 0x00442087
+        if (header.flags & S5Flags::hasSaveDetails)
         {
-            file->saveDetails = std::make_unique<SaveDetails>();
-            fs.readChunk(file->saveDetails.get(), sizeof(file->saveDetails));
+            fs.skipChunk();
+        }
+
+        if (header.flags & S5Flags::isDelta)
+        {
+            fs.readChunk(&deltaInfo, sizeof(deltaInfo));
+            deltaInfo.baseFilename[sizeof(deltaInfo.baseFilename) - 1] = '\0';
         }
 
         // Read packed objects
-        if (file->header.numPackedObjects > 0)
+        if (header.numPackedObjects > 0)
         {
             bool objectInstalled = false;
-            for (auto i = 0; i < file->header.numPackedObjects; ++i)
+            for (auto i = 0; i < header.numPackedObjects; ++i)
             {
                 ObjectHeader object;
                 fs.read(&object, sizeof(ObjectHeader));
@@ -455,7 +613,7 @@ namespace OpenLoco::S5
             // 0x004420B2
         }
 
-        if (file->header.type == S5Type::objects)
+        if (header.type == S5Type::objects)
         {
             addr<0x00525F62, uint16_t>() = 0;
             _loadErrorCode = 254;
@@ -466,20 +624,10 @@ namespace OpenLoco::S5
         else
         {
             // Load required objects
-            fs.readChunk(file->requiredObjects, sizeof(file->requiredObjects));
-
-            // Load game state
-            fs.readChunk(&file->gameState, sizeof(file->gameState));
-            fixState(file->gameState);
-
-            // Load tile elements
-            auto tileElements = fs.readChunk();
-            auto numTileElements = tileElements.size() / sizeof(TileElement);
-            file->tileElements.resize(numTileElements);
-            std::memcpy(file->tileElements.data(), tileElements.data(), numTileElements * sizeof(TileElement));
+            fs.readChunk(requiredObjects.data(), requiredObjects.size_bytes());
         }
 
-        return file;
+        return header;
     }
 
     // 0x00473BC7
@@ -519,6 +667,125 @@ namespace OpenLoco::S5
         }
     };
 
+    // Opens the base save of a delta save, leaving the stream at its game state
+    static std::unique_ptr<SawyerStreamReader> openDeltaBase(const fs::path& path, const DeltaInfo& deltaInfo)
+    {
+        if (deltaInfo.pageSize != deltaPageSize)
+        {
+            throw LoadException("Unsupported delta page size", StringIds::error_file_contains_invalid_data);
+        }
+
+        std::unique_ptr<SawyerStreamReader> base;
+        try
+        {
+            base = std::make_unique<SawyerStreamReader>(path.parent_path() / fs::u8path(deltaInfo.baseFilename));
+        }
+        catch (const std::exception&)
+        {
+            throw LoadException("Unable to open the base save of a delta save", StringIds::error_file_contains_invalid_data);
+        }
+        if (!base->validateChecksum())
+        {
+            throw LoadException("Invalid checksum in the base save of a delta save", StringIds::error_file_contains_invalid_data);
+        }
+
+        Header header{};
+        base->readChunk(&header, sizeof(header));
+        if (header.type != S5Type::savedGame || header.numPackedObjects != 0 || (header.flags & (S5Flags::isDelta | S5Flags::isRaw | S5Flags::isDump)))
+        {
+            throw LoadException("Invalid base save of a delta save", StringIds::error_file_contains_invalid_data);
+        }
+        if (header.flags & S5Flags::hasSaveDetails)
+        {
+            base->skipChunk();
+        }
+
+        // Skip the required objects, which match those of the delta
+        base->skipChunk();
+        return base;
+    }
+
+    // Copies each page of a page chunk written by writeChangedPages over the data
+    static void applyChangedPages(stdx::span<uint8_t const> pages, void* data, size_t size)
+    {
+        auto bytes = reinterpret_cast<uint8_t*>(data);
+        size_t position = 0;
+        while (position < pages.size())
+        {
+            uint32_t index;
+            if (pages.size() - position < sizeof(index))
+            {
+                throw std::runtime_error("Invalid delta page");
+            }
+            std::memcpy(&index, pages.data() + position, sizeof(index));
+            position += sizeof(index);
+
+            const auto offset = static_cast<size_t>(index) * deltaPageSize;
+            if (offset >= size)
+            {
+                throw std::runtime_error("Invalid delta page");
+            }
+            const auto length = std::min<size_t>(deltaPageSize, size - offset);
+            if (pages.size() - position < length)
+            {
+                throw std::runtime_error("Invalid delta page");
+            }
+            std::memcpy(bytes + offset, pages.data() + position, length);
+            position += length;
+        }
+    }
+
+    std::optional<fs::path> getDeltaBase(const fs::path& path)
+    {
+        try
+        {
+            SawyerStreamReader stream(path);
+            Header header{};
+            stream.readChunk(&header, sizeof(header));
+            if (!(header.flags & S5Flags::isDelta))
+            {
+                return std::nullopt;
+            }
+            if (header.flags & S5Flags::hasSaveDetails)
+            {
+                stream.skipChunk();
+            }
+
+            DeltaInfo deltaInfo{};
+            stream.readChunk(&deltaInfo, sizeof(deltaInfo));
+            deltaInfo.baseFilename[sizeof(deltaInfo.baseFilename) - 1] = '\0';
+            return path.parent_path() / fs::u8path(deltaInfo.baseFilename);
+        }
+        catch (const std::exception&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    // 0x00442403
+    // Only reads as far as the save details, safe to call from any thread
+    std::unique_ptr<SaveDetails> readSaveDetails(const fs::path& path)
+    {
+        try
+        {
+            SawyerStreamReader stream(path);
+            Header header{};
+            stream.readChunk(&header, sizeof(header));
+            if (header.version != currentVersion || header.type != S5Type::savedGame || (header.flags & (S5Flags::isRaw | S5Flags::isDump | S5Flags::isTitleSequence)) || !(header.flags & S5Flags::hasSaveDetails))
+            {
+                return nullptr;
+            }
+
+            auto saveDetails = std::make_unique<SaveDetails>();
+            stream.readChunk(saveDetails.get(), sizeof(SaveDetails));
+            return saveDetails;
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
     static void sub_42F7F8()
     {
         call(0x0042F7F8);
@@ -543,9 +810,12 @@ namespace OpenLoco::S5
 
         try
         {
-            auto file = load(path);
+            SawyerStreamReader fs(path);
+            auto requiredObjects = std::make_unique<ObjectHeader[]>(ObjectManager::maxObjects);
+            DeltaInfo deltaInfo{};
+            auto header = readHeader(fs, stdx::span<ObjectHeader>(requiredObjects.get(), ObjectManager::maxObjects), deltaInfo);
 
-            if (file->header.version != currentVersion)
+            if (header.version != currentVersion)
             {
                 throw LoadException("Unsupported S5 version", StringIds::error_file_contains_invalid_data);
             }
@@ -553,46 +823,53 @@ namespace OpenLoco::S5
 #ifdef DO_TITLE_SEQUENCE_CHECKS
             if (flags & LoadFlags::titleSequence)
             {
-                if (!(file->header.flags & S5Flags::isTitleSequence))
+                if (!(header.flags & S5Flags::isTitleSequence))
                 {
                     throw LoadException("File was not a title sequence", StringIds::error_file_contains_invalid_data);
                 }
             }
             else
             {
-                if (file->header.flags & S5Flags::isTitleSequence)
+                if (header.flags & S5Flags::isTitleSequence)
                 {
                     throw LoadException("File is a title sequence", StringIds::error_file_contains_invalid_data);
                 }
             }
 #endif
 
-            if (file->header.type == S5Type::scenario)
+            if (header.type == S5Type::scenario)
             {
                 throw LoadException("File is a scenario, not a saved game", StringIds::error_file_contains_invalid_data);
             }
 
-            if ((file->header.flags & S5Flags::isRaw) || (file->header.flags & S5Flags::isDump))
+            if ((header.flags & S5Flags::isRaw) || (header.flags & S5Flags::isDump))
             {
                 throw LoadException("Unsupported S5 format", StringIds::error_file_contains_invalid_data);
             }
 
             if (flags & LoadFlags::twoPlayer)
             {
-                if (file->header.type != S5Type::landscape)
+                if (header.type != S5Type::landscape)
                 {
                     throw LoadException("Not a two player saved game", StringIds::error_file_is_not_two_player_save);
                 }
             }
             else
             {
-                if (file->header.type != S5Type::savedGame)
+                if (header.type != S5Type::savedGame)
                 {
                     throw LoadException("Not a single player saved game", StringIds::error_file_is_not_single_player_save);
                 }
             }
 
-            auto loadObjectResult = ObjectManager::loadAll(file->requiredObjects);
+            // Opened and validated before loadAll swaps the live objects, so a missing base leaves the current game intact
+            std::unique_ptr<SawyerStreamReader> deltaBase;
+            if (header.flags & S5Flags::isDelta)
+            {
+                deltaBase = openDeltaBase(path, deltaInfo);
+            }
+
+            auto loadObjectResult = ObjectManager::loadAll(stdx::span<ObjectHeader>(requiredObjects.get(), ObjectManager::maxObjects));
             if (!loadObjectResult.success)
             {
                 setObjectErrorMessage(loadObjectResult.problemObject);
@@ -610,11 +887,56 @@ namespace OpenLoco::S5
             }
 
             ObjectManager::reloadAll();
+            _deltaBase.reset();
 
-            _gameState = file->gameState;
-            TileManager::setElements(stdx::span<Map::TileElement>(reinterpret_cast<Map::TileElement*>(file->tileElements.data()), file->tileElements.size()));
+            // Decode the game state and tile elements straight into place, there is no going back from here
+            try
+            {
+                // A delta save only has the pages that changed since its base save
+                auto& stateStream = deltaBase != nullptr ? *deltaBase : fs;
+
+                // Older saves have a shorter game state that fixState moves into place
+                auto gameStateSize = stateStream.readChunk(&*_gameState, sizeof(GameState));
+                if (gameStateSize < sizeof(GameState))
+                {
+                    std::memset(reinterpret_cast<uint8_t*>(&*_gameState) + gameStateSize, 0, sizeof(GameState) - gameStateSize);
+                }
+
+                auto elements = TileManager::getElementStorage();
+                auto numElements = stateStream.readChunk(elements.data(), elements.size_bytes()) / sizeof(TileElement);
+                if (deltaBase != nullptr)
+                {
+                    numElements = deltaInfo.numTileElements;
+                    if (numElements > elements.size())
+                    {
+                        throw std::runtime_error("Too many tile elements");
+                    }
+                    applyChangedPages(fs.readChunk(), &*_gameState, sizeof(GameState));
+                    applyChangedPages(fs.readChunk(), elements.data(), numElements * sizeof(TileElement));
+                    deltaBase->close();
+                }
+
+                fixState(_gameState);
+                TileManager::setElements(elements.subspan(0, std::min(numElements, elements.size())));
+                fs.close();
+            }
+            catch (const std::exception& e)
+            {
+                std::fprintf(stderr, "Unable to load S5: %s\n", e.what());
+                _loadErrorCode = 255;
+                _loadErrorMessage = StringIds::error_file_contains_invalid_data;
+                if (flags & LoadFlags::twoPlayer)
+                {
+                    sub_42F7F8();
+                    addr<0x00525F62, uint16_t>() = 0;
+                    return false;
+                }
+                Game::returnToTitle();
+                return false;
+            }
 
             EntityManager::resetSpatialIndex();
+            ParticleManager::reset();
             CompanyManager::updateColours();
             call(0x004748FA);
             TileManager::resetSurfaceClearance();
@@ -632,10 +954,10 @@ namespace OpenLoco::S5
             if (mainWindow != nullptr)
             {
                 SavedViewSimple savedView;
-                savedView.mapX = file->gameState.savedViewX;
-                savedView.mapY = file->gameState.savedViewY;
-                savedView.zoomLevel = static_cast<ZoomLevel>(file->gameState.savedViewZoom);
-                savedView.rotation = file->gameState.savedViewRotation;
+                savedView.mapX = _gameState->savedViewX;
+                savedView.mapY = _gameState->savedViewY;
+                savedView.zoomLevel = static_cast<ZoomLevel>(_gameState->savedViewZoom);
+                savedView.rotation = _gameState->savedViewRotation;
                 mainWindow->viewportFromSavedView(savedView);
                 mainWindow->invalidate();
             }
@@ -4,6 +4,7 @@
 #include "../Objects/ObjectManager.h"
 #include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace OpenLoco::S5
 {
@@ -21,6 +22,9 @@ namespace OpenLoco::S5
         constexpr uint8_t isDump = 1 << 1;
         constexpr uint8_t isTitleSequence = 1 << 2;
         constexpr uint8_t hasSaveDetails = 1 << 3;
+        constexpr uint8_t isDelta = 1 << 4;                 // new in OpenLoco, see saveDelta
+        constexpr uint8_t isLzCompressed = 1 << 5;          // new in OpenLoco, game state and tiles use SawyerEncoding::lz
+        constexpr uint8_t hasExtendedTileElements = 1 << 6; // new in OpenLoco, more tile elements than the original game has room for
     }
 
 #pragma pack(push, 1)
@@ -95,8 +99,10 @@ namespace OpenLoco::S5
 
         // new fields:
         LandGeneratorType generator;
+        uint32_t seed;          // Seed for the improved land generator, zero picks a new one each time
+        uint32_t generatedSeed; // Seed the current landscape was generated from
 
-        std::byte pad_41BD[348];
+        std::byte pad_41C6[340];
     };
 #pragma pack(pop)
 
@@ -282,6 +288,7 @@ namespace OpenLoco::S5
         packCustomObjects = 1 << 0,
         scenario = 1 << 1,
         landscape = 1 << 2,
+        lzCompression = 1 << 3, // Faster to write than the original encodings but unreadable by the original game
         noWindowClose = 1u << 29,
         raw = 1u << 30,  // Save raw data including pointers with no clean up
         dump = 1u << 31, // Used for dumping the game state when there is a fatal error
@@ -296,6 +303,9 @@ namespace OpenLoco::S5
     Options& getOptions();
     Options& getPreviewOptions();
     bool save(const fs::path& path, SaveFlags flags);
+    bool saveDelta(const fs::path& path, SaveFlags flags, int32_t rebaseInterval);
+    std::optional<fs::path> getDeltaBase(const fs::path& path);
+    std::unique_ptr<SaveDetails> readSaveDetails(const fs::path& path);
     void registerHooks();
 
     bool load(const fs::path& path, uint32_t flags);
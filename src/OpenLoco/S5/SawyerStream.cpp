@@ -5,6 +5,7 @@
 #include <cstring>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -19,6 +20,15 @@ using namespace OpenLoco::Utility;
 
 constexpr const char* exceptionInvalidRLE = "Invalid RLE run";
 constexpr const char* exceptionUnknownEncoding = "Unknown encoding";
+constexpr const char* exceptionEndOfFile = "Unexpected end of file";
+constexpr const char* exceptionInvalidLz = "Invalid LZ sequence";
+
+// SawyerEncoding::lz is a byte oriented LZ77 in the style of LZ4: the decoded length, then sequences of a token
+// with the literal and match lengths in its upper and lower nibble, the literals, a 16 bit match offset and any
+// length overflow bytes. The last sequence only has literals.
+constexpr size_t lzMinMatch = 4;
+constexpr size_t lzMaxOffset = 0xFFFF;
+constexpr uint32_t lzHashBits = 16;
 
 uint8_t* FastBuffer::alloc(size_t len)
 {
@@ -124,78 +134,179 @@ stdx::span<uint8_t const> FastBuffer::getSpan() const
     return stdx::span<uint8_t const>(_data, _len);
 }
 
+/**
+ * Writes decoded bytes straight into a fixed size destination. Bytes past the end are counted but dropped,
+ * matching readChunk(data, maxDataLen) copying at most maxDataLen bytes of a longer chunk.
+ */
+class SpanWriter
+{
+private:
+    uint8_t* _data;
+    size_t _capacity;
+    size_t _len{};
+
+public:
+    SpanWriter(void* data, size_t capacity)
+        : _data(reinterpret_cast<uint8_t*>(data))
+        , _capacity(capacity)
+    {
+    }
+
+    size_t size() const
+    {
+        return _len;
+    }
+
+    uint8_t at(size_t index) const
+    {
+        return index < _capacity ? _data[index] : 0;
+    }
+
+    void reserve(size_t)
+    {
+    }
+
+    void push_back(uint8_t value)
+    {
+        if (_len < _capacity)
+        {
+            _data[_len] = value;
+        }
+        _len++;
+    }
+
+    void push_back(uint8_t value, size_t len)
+    {
+        if (_len < _capacity)
+        {
+            std::memset(&_data[_len], value, std::min(len, _capacity - _len));
+        }
+        _len += len;
+    }
+
+    void push_back(const uint8_t* src, size_t len)
+    {
+        if (_len < _capacity)
+        {
+            std::memcpy(&_data[_len], src, std::min(len, _capacity - _len));
+        }
+        _len += len;
+    }
+};
+
+static uint8_t getByte(FastBuffer& buffer, size_t index)
+{
+    return buffer.data()[index];
+}
+
+static uint8_t getByte(SpanWriter& buffer, size_t index)
+{
+    return buffer.at(index);
+}
+
 SawyerStreamReader::SawyerStreamReader(const fs::path& path)
 {
-    _stream.exceptions(std::ifstream::failbit);
-    _stream.open(path, std::ios::in | std::ios::binary);
+    if (!_file.map(path))
+    {
+        throw std::runtime_error("Unable to open " + path.u8string());
+    }
 }
 
-stdx::span<uint8_t const> SawyerStreamReader::readChunk()
+stdx::span<uint8_t const> SawyerStreamReader::readChunkData(SawyerEncoding& encoding)
 {
-    SawyerEncoding encoding;
     read(&encoding, sizeof(encoding));
 
     uint32_t length;
     read(&length, sizeof(length));
+    if (length > _file.size() - _position)
+    {
+        throw std::runtime_error(exceptionEndOfFile);
+    }
 
-    _decodeBuffer.resize(length);
-    read(_decodeBuffer.data(), length);
+    auto data = stdx::span<uint8_t const>(reinterpret_cast<const uint8_t*>(_file.data()) + _position, length);
+    _position += length;
+    return data;
+}
 
-    return decode(encoding, _decodeBuffer.getSpan());
+stdx::span<uint8_t const> SawyerStreamReader::readChunk()
+{
+    SawyerEncoding encoding;
+    auto data = readChunkData(encoding);
+    return decode(encoding, data);
 }
 
 size_t SawyerStreamReader::readChunk(void* data, size_t maxDataLen)
 {
-    auto chunkData = readChunk();
-    std::memcpy(data, chunkData.data(), std::min(chunkData.size(), maxDataLen));
-    return chunkData.size();
+    SawyerEncoding encoding;
+    auto chunkData = readChunkData(encoding);
+
+    SpanWriter writer(data, maxDataLen);
+    switch (encoding)
+    {
+        case SawyerEncoding::uncompressed:
+            writer.push_back(chunkData.data(), chunkData.size());
+            break;
+        case SawyerEncoding::runLengthSingle:
+            decodeRunLengthSingle(writer, chunkData);
+            break;
+        case SawyerEncoding::runLengthMulti:
+            _decodeBuffer2.clear();
+            _decodeBuffer2.reserve(chunkData.size());
+            decodeRunLengthSingle(_decodeBuffer2, chunkData);
+            decodeRunLengthMulti(writer, _decodeBuffer2.getSpan());
+            break;
+        case SawyerEncoding::rotate:
+            decodeRotate(writer, chunkData);
+            break;
+        case SawyerEncoding::lz:
+            decodeLz(writer, chunkData);
+            break;
+        default:
+            throw std::runtime_error(exceptionUnknownEncoding);
+    }
+    return writer.size();
+}
+
+void SawyerStreamReader::skipChunk()
+{
+    SawyerEncoding encoding;
+    readChunkData(encoding);
 }
 
 void SawyerStreamReader::read(void* data, size_t dataLen)
 {
-    _stream.read(reinterpret_cast<char*>(data), dataLen);
+    if (dataLen > _file.size() - _position)
+    {
+        throw std::runtime_error(exceptionEndOfFile);
+    }
+    std::memcpy(data, _file.data() + _position, dataLen);
+    _position += dataLen;
 }
 
 bool SawyerStreamReader::validateChecksum()
 {
-    auto valid = false;
-    auto backupPos = _stream.tellg();
-
-    _stream.seekg(0, std::ios::end);
-    auto fileLength = static_cast<uint32_t>(_stream.tellg());
-    if (fileLength >= 4)
+    auto fileLength = _file.size();
+    if (fileLength < 4)
     {
-        // Read checksum
-        uint32_t checksum;
-        _stream.seekg(fileLength - 4);
-        _stream.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
-
-        // Calculate checksum
-        uint32_t actualChecksum = 0;
-        _stream.seekg(0);
-        uint8_t buffer[2048];
-        for (uint32_t i = 0; i < fileLength - 4; i += sizeof(buffer))
-        {
-            auto readLength = std::min<size_t>(sizeof(buffer), fileLength - 4 - i);
-            _stream.read(reinterpret_cast<char*>(buffer), readLength);
-            for (size_t j = 0; j < readLength; j++)
-            {
-                actualChecksum += buffer[j];
-            }
-        }
-
-        valid = checksum == actualChecksum;
+        return false;
     }
 
-    // Restore position
-    _stream.seekg(backupPos);
+    uint32_t checksum;
+    std::memcpy(&checksum, _file.data() + fileLength - 4, sizeof(checksum));
 
-    return valid;
+    uint32_t actualChecksum = 0;
+    auto data = reinterpret_cast<const uint8_t*>(_file.data());
+    for (size_t i = 0; i < fileLength - 4; i++)
+    {
+        actualChecksum += data[i];
+    }
+    return checksum == actualChecksum;
 }
 
 void SawyerStreamReader::close()
 {
-    _stream.close();
+    _file.unmap();
+    _position = 0;
 }
 
 stdx::span<uint8_t const> SawyerStreamReader::decode(SawyerEncoding encoding, stdx::span<uint8_t const> data)
@@ -223,12 +334,47 @@ stdx::span<uint8_t const> SawyerStreamReader::decode(SawyerEncoding encoding, st
             _decodeBuffer2.reserve(data.size());
             decodeRotate(_decodeBuffer2, data);
             return _decodeBuffer2.getSpan();
+        case SawyerEncoding::lz:
+            _decodeBuffer2.clear();
+            decodeLz(_decodeBuffer2, data);
+            return _decodeBuffer2.getSpan();
         default:
             throw std::runtime_error(exceptionUnknownEncoding);
     }
 }
 
-void SawyerStreamReader::decodeRunLengthSingle(FastBuffer& buffer, stdx::span<uint8_t const> data)
+// Decodes chunk data that did not come from a file, such as a chunk that has just been encoded
+void SawyerStreamReader::decode(SawyerEncoding encoding, stdx::span<uint8_t const> data, FastBuffer& buffer)
+{
+    buffer.clear();
+    switch (encoding)
+    {
+        case SawyerEncoding::uncompressed:
+            buffer.push_back(data.data(), data.size());
+            break;
+        case SawyerEncoding::runLengthSingle:
+            decodeRunLengthSingle(buffer, data);
+            break;
+        case SawyerEncoding::runLengthMulti:
+        {
+            FastBuffer runs;
+            decodeRunLengthSingle(runs, data);
+            decodeRunLengthMulti(buffer, runs.getSpan());
+            break;
+        }
+        case SawyerEncoding::rotate:
+            decodeRotate(buffer, data);
+            break;
+        case SawyerEncoding::lz:
+            decodeLz(buffer, data);
+            break;
+        default:
+            throw std::runtime_error(exceptionUnknownEncoding);
+    }
+}
+
+template<typename TBuffer>
+void SawyerStreamReader::decodeRunLengthSingle(TBuffer& buffer, stdx::span<uint8_t const> data)
 {
     for (size_t i = 0; i < data.size(); i++)
     {
@@ -259,7 +405,8 @@ void SawyerStreamReader::decodeRunLengthSingle(FastBuffer& buffer, stdx::span<ui
     }
 }
 
-void SawyerStreamReader::decodeRunLengthMulti(FastBuffer& buffer, stdx::span<uint8_t const> data)
+template<typename TBuffer>
+void SawyerStreamReader::decodeRunLengthMulti(TBuffer& buffer, stdx::span<uint8_t const> data)
 {
     for (size_t i = 0; i < data.size(); i++)
     {
@@ -280,20 +427,19 @@ void SawyerStreamReader::decodeRunLengthMulti(FastBuffer& buffer, stdx::span<uin
             {
                 throw std::runtime_error(exceptionInvalidRLE);
             }
-            auto copySrc = buffer.data() + buffer.size() + offset;
             auto copyLen = static_cast<size_t>((data[i] & 7) + 1);
 
-            // Copy it to temp buffer first as we can't copy buffer to itself due to potential
-            // realloc in between reserve and push
-            uint8_t copyBuffer[32];
-            assert(copyLen <= sizeof(copyBuffer));
-            std::memcpy(copyBuffer, copySrc, copyLen);
-            buffer.push_back(copyBuffer, copyLen);
+            // Copy a byte at a time as the buffer may realloc on push and the run may overlap itself
+            for (size_t j = 0; j < copyLen; j++)
+            {
+                buffer.push_back(getByte(buffer, buffer.size() + offset));
+            }
         }
     }
 }
 
-void SawyerStreamReader::decodeRotate(FastBuffer& buffer, stdx::span<uint8_t const> data)
+template<typename TBuffer>
+void SawyerStreamReader::decodeRotate(TBuffer& buffer, stdx::span<uint8_t const> data)
 {
     uint8_t code = 1;
     for (size_t i = 0; i < data.size(); i++)
@@ -303,6 +449,100 @@ void SawyerStreamReader::decodeRotate(FastBuffer& buffer, stdx::span<uint8_t con
     }
 }
 
+static size_t readLzLength(stdx::span<uint8_t const> data, size_t& i, size_t length)
+{
+    if (length != 15)
+    {
+        return length;
+    }
+    for (;;)
+    {
+        if (i >= data.size())
+        {
+            throw std::runtime_error(exceptionInvalidLz);
+        }
+        auto value = data[i++];
+        length += value;
+        if (value != 255)
+        {
+            return length;
+        }
+    }
+}
+
+// Copies a byte at a time as the match may overlap itself
+template<typename TBuffer>
+static void copyLzMatch(TBuffer& buffer, size_t offset, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        buffer.push_back(getByte(buffer, buffer.size() - offset));
+    }
+}
+
+static void copyLzMatch(FastBuffer& buffer, size_t offset, size_t length)
+{
+    if (offset < length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            buffer.push_back(buffer.data()[buffer.size() - offset]);
+        }
+        return;
+    }
+
+    // Reserve first so the source stays valid
+    buffer.reserve(buffer.size() + length);
+    buffer.push_back(buffer.data() + buffer.size() - offset, length);
+}
+
+template<typename TBuffer>
+void SawyerStreamReader::decodeLz(TBuffer& buffer, stdx::span<uint8_t const> data)
+{
+    uint32_t decodedLength;
+    if (data.size() < sizeof(decodedLength))
+    {
+        throw std::runtime_error(exceptionInvalidLz);
+    }
+    std::memcpy(&decodedLength, data.data(), sizeof(decodedLength));
+    buffer.reserve(std::min<size_t>(decodedLength, data.size() * 255));
+
+    size_t i = sizeof(decodedLength);
+    while (i < data.size())
+    {
+        auto token = data[i++];
+        auto literalLength = readLzLength(data, i, token >> 4);
+        if (literalLength > data.size() - i)
+        {
+            throw std::runtime_error(exceptionInvalidLz);
+        }
+        buffer.push_back(data.data() + i, literalLength);
+        i += literalLength;
+        if (i == data.size())
+        {
+            break;
+        }
+
+        if (data.size() - i < 2)
+        {
+            throw std::runtime_error(exceptionInvalidLz);
+        }
+        size_t offset = data[i] | (data[i + 1] << 8);
+        i += 2;
+        if (offset == 0 || offset > buffer.size())
+        {
+            throw std::runtime_error(exceptionInvalidLz);
+        }
+
+        copyLzMatch(buffer, offset, readLzLength(data, i, token & 15) + lzMinMatch);
+    }
+
+    if (buffer.size() != decodedLength)
+    {
+        throw std::runtime_error(exceptionInvalidLz);
+    }
+}
+
 SawyerStreamWriter::SawyerStreamWriter(const fs::path& path)
 {
     _stream.exceptions(std::ifstream::failbit);
@@ -312,6 +552,12 @@ SawyerStreamWriter::SawyerStreamWriter(const fs::path& path)
 void SawyerStreamWriter::writeChunk(SawyerEncoding chunkType, const void* data, size_t dataLen)
 {
     auto encodedData = encode(chunkType, stdx::span(reinterpret_cast<const uint8_t*>(data), dataLen));
+#if DEBUG
+    // Every encoding must give back exactly the data it was given
+    FastBuffer decodedData;
+    SawyerStreamReader::decode(chunkType, encodedData, decodedData);
+    assert(decodedData.size() == dataLen && (dataLen == 0 || std::memcmp(decodedData.data(), data, dataLen) == 0));
+#endif
     write(&chunkType, sizeof(chunkType));
     write(static_cast<uint32_t>(encodedData.size()));
     write(encodedData.data(), encodedData.size());
@@ -362,6 +608,11 @@ stdx::span<uint8_t const> SawyerStreamWriter::encode(SawyerEncoding encoding, st
             _encodeBuffer.reserve(data.size());
             encodeRotate(_encodeBuffer, data);
             return _encodeBuffer.getSpan();
+        case SawyerEncoding::lz:
+            _encodeBuffer.clear();
+            _encodeBuffer.reserve(data.size() / 2);
+            encodeLz(_encodeBuffer, data);
+            return _encodeBuffer.getSpan();
         default:
             throw std::runtime_error(exceptionUnknownEncoding);
     }
@@ -486,3 +737,83 @@ void SawyerStreamWriter::encodeRotate(FastBuffer& buffer, stdx::span<uint8_t con
         code = (code + 2) & 7;
     }
 }
+
+static void writeLzLength(FastBuffer& buffer, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        buffer.push_back(255);
+    }
+    buffer.push_back(static_cast<uint8_t>(length));
+}
+
+static void writeLzSequence(FastBuffer& buffer, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength)
+{
+    // The last sequence has no match, its match nibble is left at zero
+    const auto matchCode = matchLength != 0 ? matchLength - lzMinMatch : 0;
+    buffer.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+    if (literalLength >= 15)
+    {
+        writeLzLength(buffer, literalLength - 15);
+    }
+    if (literalLength != 0)
+    {
+        buffer.push_back(literals, literalLength);
+    }
+    if (matchLength == 0)
+    {
+        return;
+    }
+
+    buffer.push_back(static_cast<uint8_t>(offset & 0xFF));
+    buffer.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15)
+    {
+        writeLzLength(buffer, matchCode - 15);
+    }
+}
+
+// Greedy parse with a single candidate per hash of the next four bytes, skipping ahead faster through data
+// that does not compress
+void SawyerStreamWriter::encodeLz(FastBuffer& buffer, stdx::span<uint8_t const> data)
+{
+    const auto src = data.data();
+    const auto srcLen = data.size();
+    const auto decodedLength = static_cast<uint32_t>(srcLen);
+    buffer.push_back(reinterpret_cast<const uint8_t*>(&decodedLength), sizeof(decodedLength));
+
+    auto read32 = [src](size_t i) {
+        uint32_t value;
+        std::memcpy(&value, src + i, sizeof(value));
+        return value;
+    };
+
+    std::vector<uint32_t> table(1 << lzHashBits, 0);
+    size_t anchor = 0;
+    size_t i = 1;
+    while (i + lzMinMatch <= srcLen)
+    {
+        const auto sequence = read32(i);
+        const auto hash = (sequence * 2654435761u) >> (32 - lzHashBits);
+        const size_t candidate = table[hash];
+        table[hash] = static_cast<uint32_t>(i);
+
+        if (candidate >= i || i - candidate > lzMaxOffset || read32(candidate) != sequence)
+        {
+            i += 1 + ((i - anchor) >> 6);
+            continue;
+        }
+
+        auto matchLength = lzMinMatch;
+        while (i + matchLength < srcLen && src[candidate + matchLength] == src[i + matchLength])
+        {
+            matchLength++;
+        }
+
+        writeLzSequence(buffer, src + anchor, i - anchor, i - candidate, matchLength);
+        i += matchLength;
+        anchor = i;
+    }
+
+    writeLzSequence(buffer, src + anchor, srcLen - anchor, 0, 0);
+}
@@ -2,6 +2,7 @@
 
 #include "../Core/FileSystem.hpp"
 #include "../Core/Span.hpp"
+#include "../Platform/Platform.h"
 #include <cstdint>
 #include <fstream>
 
@@ -13,6 +14,7 @@ namespace OpenLoco
         runLengthSingle,
         runLengthMulti,
         rotate,
+        lz, // new in OpenLoco, not readable by the original game
     };
 
     /**
@@ -48,23 +50,37 @@ namespace OpenLoco
         stdx::span<uint8_t const> getSpan() const;
     };
 
+    /**
+     * Reads chunks from a memory mapped file. Uncompressed chunks are returned straight from the mapping and
+     * readChunk(data, maxDataLen) decodes into the destination without going through an intermediate buffer.
+     */
     class SawyerStreamReader
     {
     private:
-        std::ifstream _stream;
+        platform::MappedFile _file;
+        size_t _position{};
         FastBuffer _decodeBuffer;
         FastBuffer _decodeBuffer2;
 
+        stdx::span<uint8_t const> readChunkData(SawyerEncoding& encoding);
         stdx::span<uint8_t const> decode(SawyerEncoding encoding, stdx::span<uint8_t const> data);
-        static void decodeRunLengthSingle(FastBuffer& buffer, stdx::span<uint8_t const> data);
-        static void decodeRunLengthMulti(FastBuffer& buffer, stdx::span<uint8_t const> data);
-        static void decodeRotate(FastBuffer& buffer, stdx::span<uint8_t const> data);
+        template<typename TBuffer>
+        static void decodeRunLengthSingle(TBuffer& buffer, stdx::span<uint8_t const> data);
+        template<typename TBuffer>
+        static void decodeRunLengthMulti(TBuffer& buffer, stdx::span<uint8_t const> data);
+        template<typename TBuffer>
+        static void decodeRotate(TBuffer& buffer, stdx::span<uint8_t const> data);
+        template<typename TBuffer>
+        static void decodeLz(TBuffer& buffer, stdx::span<uint8_t const> data);
 
     public:
         SawyerStreamReader(const fs::path& path);
 
+        static void decode(SawyerEncoding encoding, stdx::span<uint8_t const> data, FastBuffer& buffer);
+
         stdx::span<uint8_t const> readChunk();
         size_t readChunk(void* data, size_t maxDataLen);
+        void skipChunk();
         void read(void* data, size_t dataLen);
         bool validateChecksum();
         void close();
@@ -82,6 +98,7 @@ namespace OpenLoco
         static void encodeRunLengthSingle(FastBuffer& buffer, stdx::span<uint8_t const> data);
         static void encodeRunLengthMulti(FastBuffer& buffer, stdx::span<uint8_t const> data);
         static void encodeRotate(FastBuffer& buffer, stdx::span<uint8_t const> data);
+        static void encodeLz(FastBuffer& buffer, stdx::span<uint8_t const> data);
 
     public:
         SawyerStreamWriter(const fs::path& path);
@@ -17,6 +17,8 @@
 #include "TownManager.h"
 #include "Ui/WindowManager.h"
 #include "Windows/Construction/Construction.h"
+#include <limits>
+#include <random>
 
 using namespace OpenLoco::Interop;
 using namespace OpenLoco::Map;
@@ -218,6 +220,17 @@ namespace OpenLoco::Scenario
     void generateLandscape()
     {
         auto& options = S5::getOptions();
+
+        // Record the seed used so the same landscape can be generated again by entering it
+        if (options.seed != 0)
+        {
+            options.generatedSeed = options.seed;
+        }
+        else
+        {
+            std::random_device rd;
+            options.generatedSeed = std::uniform_int_distribution<uint32_t>(1, std::numeric_limits<int32_t>::max())(rd);
+        }
         MapGenerator::generate(options);
         options.madeAnyChanges = 0;
         addr<0x00F25374, uint8_t>() = 0;
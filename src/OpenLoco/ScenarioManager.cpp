@@ -1,88 +1,419 @@
 #include "ScenarioManager.h"
+#include "Console.h"
+#include "Core/FileSystem.hpp"
+#include "EditorController.h"
+#include "Environment.h"
 #include "Interop/Interop.hpp"
+#include "Localisation/StringIds.h"
+#include "OpenLoco.h"
+#include "S5/S5.h"
+#include "Scenario.h"
+#include "Utility/String.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenLoco::Interop;
 
 namespace OpenLoco::ScenarioManager
 {
+#pragma pack(push, 1)
+    // Header of scores.dat, which is followed by the index entries
+    struct IndexHeader
+    {
+        uint32_t fileCount; // Number of scenario files in the lower 24 bits, version in the upper 8
+        uint64_t fileSizes; // Sum of the sizes of all scenario files
+    };
+    static_assert(sizeof(IndexHeader) == 0x0C);
+
+    // Size and modification time of each scenario file, kept alongside scores.dat to tell which files changed
+    struct FileKeysHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numKeys;
+    };
+
+    struct FileKey
+    {
+        char filename[0x100];
+        uint64_t size;
+        int64_t modified;
+    };
+#pragma pack(pop)
+
+    constexpr uint32_t indexVersion = 1;
+    constexpr uint32_t fileKeysMagic = 0x49534C4F; // OLSI
+    constexpr uint32_t fileKeysVersion = 1;
+    constexpr size_t indexGrowth = 16;
+    constexpr int32_t maxIndexEntries = 0x10000;
+    constexpr uint8_t numCategories = 5;
+    constexpr uint32_t outOfMemoryError = 0xFF000002;
+
     loco_global<ScenarioIndexEntry*, 0x0050AE8C> scenarioList;
+    loco_global<uint32_t, 0x0050AE90> scenarioListSize;
+    loco_global<IndexHeader, 0x0050AE94> indexHeader;
     loco_global<int32_t, 0x0050AEA0> scenarioCount;
+    static loco_global<char[257], 0x0050B406> _pathScenarios;
+    static loco_global<char[512], 0x0112CE04> _scenarioPath;
 
-    bool hasScenariosForCategory(uint8_t category)
+    static std::array<std::vector<ScenarioIndexEntry*>, numCategories> _categories;
+    static ScenarioIndexEntry* _categoriesList = nullptr;
+    static int32_t _categoriesCount = 0;
+
+    struct ScenarioFile
+    {
+        std::string filename;
+        uint64_t size;
+        int64_t modified;
+    };
+
+    static ScenarioIndexEntry* const noList = reinterpret_cast<ScenarioIndexEntry*>(-1);
+
+    // Visible scenarios of each category in index order, rebuilt whenever the index is reloaded or reallocated
+    static void updateCategories()
     {
+        if (_categoriesList == scenarioList && _categoriesCount == scenarioCount)
+            return;
+
+        for (auto& category : _categories)
+        {
+            category.clear();
+        }
+
         for (auto i = 0; i < scenarioCount; i++)
         {
             ScenarioIndexEntry& entry = scenarioList[i];
-            if (!entry.hasFlag(ScenarioIndexFlags::flag_0))
+            if (entry.category >= numCategories || !entry.hasFlag(ScenarioIndexFlags::flag_0))
                 continue;
 
-            if (entry.category == category)
-                return true;
+            _categories[entry.category].push_back(&entry);
         }
 
-        return false;
+        _categoriesList = scenarioList;
+        _categoriesCount = scenarioCount;
+    }
+
+    bool hasScenariosForCategory(uint8_t category)
+    {
+        return getScenarioCountByCategory(category) != 0;
     }
 
     bool hasScenarioInCategory(uint8_t category, ScenarioIndexEntry* scenario)
     {
-        for (auto i = 0; i < scenarioCount; i++)
+        ScenarioIndexEntry* list = scenarioList;
+        if (scenario == nullptr || list == noList || scenario < list || scenario >= list + scenarioCount)
+            return false;
+
+        return scenario->category == category && scenario->hasFlag(ScenarioIndexFlags::flag_0);
+    }
+
+    // 0x00443EF6, kind of
+    uint16_t getScenarioCountByCategory(uint8_t category)
+    {
+        if (category >= numCategories)
+            return 0;
+
+        updateCategories();
+        return static_cast<uint16_t>(_categories[category].size());
+    }
+
+    ScenarioIndexEntry* getNthScenarioFromCategory(uint8_t category, uint8_t index)
+    {
+        if (category >= numCategories)
+            return nullptr;
+
+        updateCategories();
+        const auto& entries = _categories[category];
+        return index < entries.size() ? entries[index] : nullptr;
+    }
+
+    static fs::path getScenarioDirectory()
+    {
+        return fs::u8path(std::string(_pathScenarios)).parent_path();
+    }
+
+    static fs::path getFileKeysPath()
+    {
+        return Environment::getPathNoWarning(Environment::path_id::scores).parent_path() / "scenario_index.dat";
+    }
+
+    static std::vector<ScenarioFile> scanScenarioFiles()
+    {
+        std::vector<ScenarioFile> files;
+        std::error_code ec;
+        for (const auto& file : fs::directory_iterator(getScenarioDirectory(), ec))
         {
-            ScenarioIndexEntry* entry = &scenarioList[i];
+            if (!file.is_regular_file(ec) || !Utility::iequals(file.path().extension().u8string(), ".sc5"))
+                continue;
 
-            if (entry->category != category || !entry->hasFlag(ScenarioIndexFlags::flag_0))
+            auto filename = file.path().filename().u8string();
+            if (filename.size() >= sizeof(ScenarioIndexEntry::filename))
+                continue;
+
+            const auto size = file.file_size(ec);
+            const auto modified = file.last_write_time(ec).time_since_epoch().count();
+            files.push_back({ std::move(filename), static_cast<uint64_t>(size), static_cast<int64_t>(modified) });
+        }
+        return files;
+    }
+
+    static std::unordered_map<std::string, FileKey> readFileKeys()
+    {
+        std::unordered_map<std::string, FileKey> keys;
+        std::ifstream stream(getFileKeysPath(), std::ios::in | std::ios::binary);
+        FileKeysHeader header;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != fileKeysMagic || header.version != fileKeysVersion)
+            return keys;
+
+        for (uint32_t i = 0; i < header.numKeys; i++)
+        {
+            FileKey key;
+            if (!stream.read(reinterpret_cast<char*>(&key), sizeof(key)))
+                return {};
+
+            key.filename[sizeof(key.filename) - 1] = '\0';
+            keys.emplace(key.filename, key);
+        }
+        return keys;
+    }
+
+    static void writeFileKeys(const std::vector<ScenarioFile>& files)
+    {
+        try
+        {
+            std::ofstream stream(getFileKeysPath(), std::ios::out | std::ios::binary | std::ios::trunc);
+            FileKeysHeader header = { fileKeysMagic, fileKeysVersion, static_cast<uint32_t>(files.size()) };
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const auto& file : files)
             {
-                if (entry == scenario)
-                    return false;
-                else
-                    continue;
+                FileKey key{};
+                Utility::strcpy_safe(key.filename, file.filename.c_str());
+                key.size = file.size;
+                key.modified = file.modified;
+                stream.write(reinterpret_cast<const char*>(&key), sizeof(key));
             }
+        }
+        catch (const std::exception& e)
+        {
+            Console::error("Unable to write scenario index: %s", e.what());
+        }
+    }
 
-            if (entry == scenario)
-                return true;
+    static void allocateIndex(size_t numEntries)
+    {
+        const auto size = static_cast<uint32_t>(std::max<size_t>(numEntries, indexGrowth) * sizeof(ScenarioIndexEntry));
+        auto* list = static_cast<ScenarioIndexEntry*>(std::malloc(size));
+        if (list == nullptr)
+        {
+            exitWithError(StringIds::null, outOfMemoryError);
+        }
+        scenarioList = list;
+        scenarioListSize = size;
+    }
+
+    // Reads scores.dat into a newly allocated list, returns false if it is missing or truncated
+    static bool readIndex()
+    {
+        scenarioCount = 0;
+        std::ifstream stream(Environment::getPathNoWarning(Environment::path_id::scores), std::ios::in | std::ios::binary);
+        IndexHeader header;
+        int32_t numEntries;
+        if (!stream.read(reinterpret_cast<char*>(&header), sizeof(header)) || !stream.read(reinterpret_cast<char*>(&numEntries), sizeof(numEntries)) || numEntries < 0 || numEntries > maxIndexEntries)
+        {
+            allocateIndex(0);
+            return false;
         }
 
-        return false;
+        allocateIndex(numEntries);
+        if (!stream.read(reinterpret_cast<char*>(*scenarioList), numEntries * sizeof(ScenarioIndexEntry)))
+            return false;
+
+        indexHeader = header;
+        scenarioCount = numEntries;
+        return true;
     }
 
-    // 0x00443EF6, kind of
-    uint16_t getScenarioCountByCategory(uint8_t category)
+    static ScenarioIndexEntry& appendEntry()
     {
-        auto scenarioCountInCategory = 0;
-        for (auto i = 0; i < scenarioCount; i++)
+        if ((scenarioCount + 1) * sizeof(ScenarioIndexEntry) > scenarioListSize)
         {
-            ScenarioIndexEntry& entry = scenarioList[i];
-            if (entry.category != category || !entry.hasFlag(ScenarioIndexFlags::flag_0))
-                continue;
+            const auto size = scenarioListSize + indexGrowth * sizeof(ScenarioIndexEntry);
+            auto* list = static_cast<ScenarioIndexEntry*>(std::realloc(scenarioList, size));
+            if (list == nullptr)
+            {
+                exitWithError(StringIds::null, outOfMemoryError);
+            }
+            scenarioList = list;
+            scenarioListSize = size;
+        }
 
-            scenarioCountInCategory++;
+        auto& entry = scenarioList[scenarioCount];
+        scenarioCount++;
+        entry = {};
+        return entry;
+    }
+
+    // 0x00442A08 reads the header and options of the file named in 0x0112CE04
+    static bool readScenarioFile(const std::string& filename)
+    {
+        std::string path(_pathScenarios);
+        path = path.substr(0, path.find('*')) + filename;
+        Utility::strcpy_safe(_scenarioPath, path.c_str());
+
+        registers regs;
+        if (call(0x00442A08, regs) & X86_FLAG_CARRY)
+            return false;
+
+        return S5::getOptions().editorStep == static_cast<uint8_t>(EditorController::Step::null);
+    }
+
+    // Copies the details of the scenario just read by readScenarioFile into its index entry
+    static void updateEntry(ScenarioIndexEntry& entry)
+    {
+        const auto& options = S5::getOptions();
+        entry.flags |= ScenarioIndexFlags::flag_0;
+        entry.category = options.difficulty;
+        entry.flags &= ~ScenarioIndexFlags::hasPreviewImage;
+        if (options.scenarioFlags & Scenario::flags::landscape_generation_done)
+        {
+            entry.flags |= ScenarioIndexFlags::hasPreviewImage;
         }
+        std::memcpy(entry.preview, options.preview, sizeof(entry.preview));
+        entry.startYear = options.scenarioStartYear;
+        entry.numCompetingCompanies = options.maxCompetingCompanies;
+        entry.competingCompanyDelay = options.competitorStartDelay;
+
+        // Formats the objective and copies the currency
+        registers regs;
+        regs.edi = (int32_t)&entry;
+        call(0x00444C4E, regs);
 
-        return scenarioCountInCategory;
+        Utility::strcpy_safe(entry.scenarioName, options.scenarioName);
+        Utility::strcpy_safe(entry.description, options.scenarioDetails);
     }
 
-    ScenarioIndexEntry* getNthScenarioFromCategory(uint8_t category, uint8_t index)
+    // Entries are kept in order of scenario name, 0x00444D27 did this with an insertion sort per entry
+    static void sortIndex()
+    {
+        std::vector<int32_t> order(scenarioCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [](int32_t a, int32_t b) {
+            return std::strcmp(scenarioList[a].scenarioName, scenarioList[b].scenarioName) < 0;
+        });
+
+        auto* sorted = static_cast<ScenarioIndexEntry*>(std::malloc(scenarioListSize));
+        if (sorted == nullptr)
+        {
+            exitWithError(StringIds::null, outOfMemoryError);
+        }
+        for (size_t i = 0; i < order.size(); i++)
+        {
+            std::memcpy(&sorted[i], &scenarioList[order[i]], sizeof(ScenarioIndexEntry));
+        }
+        std::free(scenarioList);
+        scenarioList = sorted;
+    }
+
+    // 0x0044452F
+    // Reloads the index from scores.dat and re-reads only the scenario files whose size or modification time
+    // changed since the index was last written. al forced a full rescan after the editor saved over a scenario,
+    // which the modification times now catch.
+    void loadIndex([[maybe_unused]] uint8_t al)
     {
-        uint8_t j = 0;
+        const auto oldScreenFlags = getScreenFlags();
+        setScreenFlag(ScreenFlags::title);
+
+        if (scenarioList != noList)
+        {
+            std::free(scenarioList);
+        }
+        _categoriesList = nullptr;
+        const bool indexValid = readIndex();
+
+        auto files = scanScenarioFiles();
+        IndexHeader header = { static_cast<uint32_t>(files.size() & 0xFFFFFF) | (indexVersion << 24), 0 };
+        for (const auto& file : files)
+        {
+            header.fileSizes += file.size;
+        }
+
+        auto keys = readFileKeys();
+        auto isUnchanged = [&keys](const ScenarioFile& file) {
+            auto key = keys.find(file.filename);
+            return key != keys.end() && key->second.size == file.size && key->second.modified == file.modified;
+        };
+
+        const bool indexMatches = indexValid && indexHeader->fileCount == header.fileCount && indexHeader->fileSizes == header.fileSizes;
+        if (indexMatches && std::all_of(files.begin(), files.end(), isUnchanged))
+        {
+            updateCategories();
+            setAllScreenFlags(oldScreenFlags);
+            return;
+        }
+
+        std::unordered_map<std::string, int32_t> entries;
         for (auto i = 0; i < scenarioCount; i++)
         {
-            ScenarioIndexEntry& entry = scenarioList[i];
-            if (entry.category != category || !entry.hasFlag(ScenarioIndexFlags::flag_0))
+            auto& entry = scenarioList[i];
+            entry.flags &= ~ScenarioIndexFlags::flag_0;
+            entry.filename[sizeof(entry.filename) - 1] = '\0';
+            entries.emplace(entry.filename, i);
+        }
+
+        size_t numRead = 0;
+        for (const auto& file : files)
+        {
+            auto existing = entries.find(file.filename);
+            if (existing != entries.end() && isUnchanged(file))
+            {
+                scenarioList[existing->second].flags |= ScenarioIndexFlags::flag_0;
                 continue;
+            }
 
-            if (j == index)
-                return &entry;
+            numRead++;
+            if (!readScenarioFile(file.filename))
+                continue;
 
-            j++;
+            if (existing != entries.end())
+            {
+                updateEntry(scenarioList[existing->second]);
+            }
+            else
+            {
+                auto& entry = appendEntry();
+                Utility::strcpy_safe(entry.filename, file.filename.c_str());
+                entry.flags = ScenarioIndexFlags::flag_0;
+                updateEntry(entry);
+            }
         }
+        Console::log("Scenario index: read %zu of %zu scenario files", numRead, files.size());
 
-        return nullptr;
+        sortIndex();
+        indexHeader = header;
+        call(0x00444B61); // Write scores.dat
+        writeFileKeys(files);
+
+        updateCategories();
+        setAllScreenFlags(oldScreenFlags);
     }
 
-    // 0x0044452F
-    void loadIndex(uint8_t al)
+    void registerHooks()
     {
-        registers regs;
-        regs.al = al;
-        call(0x0044452F, regs);
+        registerHook(
+            0x0044452F,
+            [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
+                registers backup = regs;
+                loadIndex(regs.al);
+                regs = backup;
+                return 0;
+            });
     }
 }
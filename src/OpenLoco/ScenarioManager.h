@@ -46,4 +46,5 @@ namespace OpenLoco::ScenarioManager
     uint16_t getScenarioCountByCategory(uint8_t category);
     ScenarioIndexEntry* getNthScenarioFromCategory(uint8_t category, uint8_t index);
     void loadIndex(uint8_t al);
+    void registerHooks();
 }
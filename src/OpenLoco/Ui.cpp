@@ -32,6 +32,7 @@
 #include "Config.h"
 #include "Console.h"
 #include "Drawing/FPSCounter.h"
+#include "Drawing/SoftwareDrawingEngine.h"
 #include "GameCommands/GameCommands.h"
 #include "Graphics/Gfx.h"
 #include "Gui.h"
@@ -96,6 +97,11 @@ namespace OpenLoco::Ui
     static SDL_Palette* palette;
     static std::vector<SDL_Cursor*> _cursors;
 
+    // Palette expanded to the pixel format of the window surface
+    static uint32_t _windowPalette[256];
+    static uint32_t _windowPaletteFormat = SDL_PIXELFORMAT_UNKNOWN;
+    static bool _presentAll = true;
+
     static void setWindowIcon();
     static void update(int32_t width, int32_t height);
     static void resize(int32_t width, int32_t height);
@@ -380,6 +386,8 @@ namespace OpenLoco::Ui
         screen_info->dirty_block_column_shift = widthShift;
         screen_info->dirty_block_row_shift = heightShift;
         screen_info->dirty_blocks_initialised = 1;
+
+        _presentAll = true;
     }
 
     static void positionChanged(int32_t x, int32_t y)
@@ -421,23 +429,139 @@ namespace OpenLoco::Ui
         resize(width, height);
     }
 
-    void render()
+    static void updateWindowPalette(const SDL_PixelFormat* format)
     {
-        if (window == nullptr || surface == nullptr)
-            return;
+        for (int i = 0; i < 256; i++)
+        {
+            auto& colour = palette->colors[i];
+            _windowPalette[i] = SDL_MapRGB(format, colour.r, colour.g, colour.b);
+        }
+        _windowPaletteFormat = format->format;
+    }
 
-        if (!Ui::dirtyBlocksInitialised())
+    // Expands a rect of the 8-bit screen buffer into a 32-bit surface, scaling it up by an integer factor
+    static void expandRect(const Gfx::Context& context, SDL_Surface* dst, const Rect& rect, int32_t scale)
+    {
+        const int32_t srcStride = context.width + context.pitch;
+        const int32_t width = rect.width();
+        const size_t dstRowLength = width * scale * sizeof(uint32_t);
+
+        for (int32_t y = rect.top(); y < rect.bottom(); y++)
         {
-            return;
+            const uint8_t* src = context.bits + y * srcStride + rect.left();
+            auto* dstRow = static_cast<uint8_t*>(dst->pixels) + y * scale * dst->pitch + rect.left() * scale * sizeof(uint32_t);
+            auto* out = reinterpret_cast<uint32_t*>(dstRow);
+
+            if (scale == 1)
+            {
+                int32_t x = 0;
+                for (; x + 4 <= width; x += 4)
+                {
+                    out[x + 0] = _windowPalette[src[x + 0]];
+                    out[x + 1] = _windowPalette[src[x + 1]];
+                    out[x + 2] = _windowPalette[src[x + 2]];
+                    out[x + 3] = _windowPalette[src[x + 3]];
+                }
+                for (; x < width; x++)
+                {
+                    out[x] = _windowPalette[src[x]];
+                }
+                continue;
+            }
+
+            for (int32_t x = 0; x < width; x++)
+            {
+                std::fill_n(out + x * scale, scale, _windowPalette[src[x]]);
+            }
+
+            // Remaining rows of the scaled pixels are the same as the first
+            for (int32_t i = 1; i < scale; i++)
+            {
+                std::memcpy(dstRow + i * dst->pitch, dstRow, dstRowLength);
+            }
         }
+    }
 
-        WindowManager::updateViewports();
+    // Presents only the areas of the screen that have been redrawn since the last frame
+    static bool presentDrawnRects(int32_t scale)
+    {
+        auto* windowSurface = SDL_GetWindowSurface(window);
+        if (windowSurface == nullptr || windowSurface->format->BytesPerPixel != sizeof(uint32_t))
+        {
+            return false;
+        }
 
-        if (!Intro::isActive())
+        auto& context = Gfx::screenContext();
+        if (context.bits == nullptr)
         {
-            Gfx::drawDirtyBlocks();
+            return false;
+        }
+
+        if (windowSurface->format->format != _windowPaletteFormat)
+        {
+            updateWindowPalette(windowSurface->format);
+            _presentAll = true;
+        }
+
+        // Intro does not go through the dirty blocks so always present the whole screen
+        std::vector<Rect> rects;
+        if (_presentAll || Intro::isActive())
+        {
+            rects.push_back(Rect(0, 0, Ui::width(), Ui::height()));
+        }
+        else
+        {
+            rects = Gfx::getDrawingEngine().getDrawnRects();
+        }
+
+        if (rects.empty())
+        {
+            return true;
+        }
+
+        // Updating many small rects costs more than a single larger one
+        constexpr size_t maxPresentRects = 128;
+        if (rects.size() > maxPresentRects)
+        {
+            auto bounds = rects[0];
+            for (auto& rect : rects)
+            {
+                bounds = bounds.unionWith(rect);
+            }
+            rects = { bounds };
+        }
+
+        if (SDL_MUSTLOCK(windowSurface) && SDL_LockSurface(windowSurface) < 0)
+        {
+            return false;
+        }
+
+        std::vector<SDL_Rect> windowRects;
+        windowRects.reserve(rects.size());
+        for (auto& rect : rects)
+        {
+            expandRect(context, windowSurface, rect, scale);
+            windowRects.push_back({ rect.left() * scale, rect.top() * scale, rect.width() * scale, rect.height() * scale });
+        }
+
+        if (SDL_MUSTLOCK(windowSurface))
+        {
+            SDL_UnlockSurface(windowSurface);
         }
 
+        if (SDL_UpdateWindowSurfaceRects(window, windowRects.data(), static_cast<int>(windowRects.size())))
+        {
+            Console::error("SDL_UpdateWindowSurfaceRects %s", SDL_GetError());
+            return false;
+        }
+
+        _presentAll = false;
+        return true;
+    }
+
+    // Converts and scales the whole screen through intermediate SDL surfaces
+    static void presentAll(float scaleFactor)
+    {
         // Lock the surface before setting its pixels
         if (SDL_MUSTLOCK(surface))
         {
@@ -447,12 +571,6 @@ namespace OpenLoco::Ui
             }
         }
 
-        // Draw FPS counter?
-        if (Config::getNew().showFPS)
-        {
-            Drawing::drawFPS();
-        }
-
         // Copy pixels from the virtual screen buffer to the surface
         auto& context = Gfx::screenContext();
         if (context.bits != nullptr)
@@ -466,8 +584,7 @@ namespace OpenLoco::Ui
             SDL_UnlockSurface(surface);
         }
 
-        auto scale_factor = Config::getNew().scale_factor;
-        if (scale_factor == 1 || scale_factor <= 0)
+        if (scaleFactor == 1 || scaleFactor <= 0)
         {
             if (SDL_BlitSurface(surface, nullptr, SDL_GetWindowSurface(window), nullptr))
             {
@@ -495,6 +612,41 @@ namespace OpenLoco::Ui
         SDL_UpdateWindowSurface(window);
     }
 
+    void render()
+    {
+        if (window == nullptr || surface == nullptr)
+            return;
+
+        if (!Ui::dirtyBlocksInitialised())
+        {
+            return;
+        }
+
+        WindowManager::updateViewports();
+
+        if (!Intro::isActive())
+        {
+            Gfx::drawDirtyBlocks();
+        }
+
+        // Draw FPS counter?
+        if (Config::getNew().showFPS)
+        {
+            Drawing::drawFPS();
+        }
+
+        // Integer scale factors are expanded and scaled natively, anything else goes through SDL
+        auto scaleFactor = Config::getNew().scale_factor;
+        auto integerScale = static_cast<int32_t>(scaleFactor);
+        if (integerScale < 1 || integerScale != scaleFactor || !presentDrawnRects(integerScale))
+        {
+            presentAll(scaleFactor);
+            _presentAll = true;
+        }
+
+        Gfx::getDrawingEngine().clearDrawnRects();
+    }
+
     void updatePalette(const palette_entry_t* entries, int32_t index, int32_t count)
     {
         SDL_Color base[256];
@@ -507,6 +659,7 @@ namespace OpenLoco::Ui
             base[i].a = 0;
         }
         SDL_SetPaletteColors(palette, base, 0, 256);
+        _windowPaletteFormat = SDL_PIXELFORMAT_UNKNOWN;
     }
 
     // 0x00406FBA
@@ -764,6 +917,18 @@ namespace OpenLoco::Ui
 #endif
     }
 
+    // Keeps the window responsive without dispatching anything, events stay queued for processMessages
+    void pumpMessages()
+    {
+#ifdef _LOCO_WIN32_
+        // Peeking delivers messages sent to the window, posted ones such as WM_QUIT are left in the queue
+        MSG msg;
+        PeekMessageA(&msg, nullptr, 0, 0, PM_NOREMOVE);
+#else
+        SDL_PumpEvents();
+#endif
+    }
+
     void showMessageBox(const std::string& title, const std::string& message)
     {
         SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_BUTTON_RETURNKEY_DEFAULT, title.c_str(), message.c_str(), window);
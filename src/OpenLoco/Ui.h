@@ -90,6 +90,7 @@ namespace OpenLoco::Ui
     void triggerResize();
     void render();
     bool processMessages();
+    void pumpMessages();
     void showMessageBox(const std::string& title, const std::string& message);
     Config::Resolution getResolution();
     Config::Resolution getDesktopResolution();
@@ -45,6 +45,16 @@ namespace OpenLoco::Ui
             return Rect(left, top, right - left, bottom - top);
         }
 
+        Rect unionWith(const Rect r2) const
+        {
+            int left = std::min(this->origin.x, r2.origin.x);
+            int top = std::min(this->origin.y, r2.origin.y);
+            int right = std::max(this->origin.x + this->size.width, r2.origin.x + r2.size.width);
+            int bottom = std::max(this->origin.y + this->size.height, r2.origin.y + r2.size.height);
+
+            return Rect(left, top, right - left, bottom - top);
+        }
+
         uint16_t width() const
         {
             return this->size.width;
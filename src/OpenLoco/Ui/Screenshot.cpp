@@ -1,14 +1,30 @@
 #include "Screenshot.h"
+#include "../Console.h"
 #include "../Graphics/Gfx.h"
 #include "../Interop/Interop.hpp"
 #include "../Localisation/StringIds.h"
 #include "../Platform/Platform.h"
 #include "../S5/S5.h"
 #include "../Ui.h"
+#include "../Viewport.hpp"
+#include "WindowManager.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <png.h>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #pragma warning(disable : 4611) // interaction between '_setjmp' and C++ object destruction is non-portable
 
@@ -17,6 +33,17 @@ using namespace OpenLoco::Ui;
 
 namespace OpenLoco::Input
 {
+    using Palette = std::array<png_color, 246>;
+
+    // Size in pixels of the pieces a giant screenshot is painted in, small enough for the paint struct pool
+    constexpr int32_t giantTileSize = 256;
+
+    // Highest tile element plus the tallest sprites standing on it
+    constexpr int16_t maxSpriteHeight = 1280;
+
+    // Blocks of rows waiting for the encoder, bounds the memory used by a giant screenshot
+    constexpr size_t maxQueuedBlocks = 2;
+
     static void pngWriteData(png_structp png_ptr, png_bytep data, png_size_t length)
     {
         auto ostream = static_cast<std::ostream*>(png_get_io_ptr(png_ptr));
@@ -29,40 +56,26 @@ namespace OpenLoco::Input
         ostream->flush();
     }
 
-    // 0x00452667
-    std::string saveScreenshot()
+    static Palette copyPalette()
     {
-        auto basePath = platform::getUserDirectory();
-        std::string scenarioName = S5::getOptions().scenarioName;
-
-        if (scenarioName.length() == 0)
-            scenarioName = StringManager::getString(StringIds::screenshot_filename_template);
-
-        std::string fileName = std::string(scenarioName) + ".png";
-        fs::path path;
-        int16_t suffix;
-        for (suffix = 1; suffix <= std::numeric_limits<int16_t>().max(); suffix++)
-        {
-            if (!fs::exists(basePath / fileName))
-            {
-                path = basePath / fileName;
-                break;
-            }
-
-            fileName = std::string(scenarioName) + " (" + std::to_string(suffix) + ").png";
-        }
+        static loco_global<uint8_t[256][4], 0x0113ED20> _113ED20;
 
-        if (path.empty())
+        Palette palette;
+        for (size_t i = 0; i < palette.size(); i++)
         {
-            throw std::runtime_error("Failed finding filename");
+            palette[i].blue = _113ED20[i][0];
+            palette[i].green = _113ED20[i][1];
+            palette[i].red = _113ED20[i][2];
         }
+        return palette;
+    }
 
+    static void encodePng(const fs::path& path, int32_t width, int32_t height, const Palette& palette, const std::function<const uint8_t*()>& nextRow)
+    {
         std::fstream outputStream(path.c_str(), std::ios::out | std::ios::binary);
 
-        static loco_global<uint8_t[256][4], 0x0113ED20> _113ED20;
-
         png_structp png_ptr = nullptr;
-        png_colorp palette = nullptr;
+        png_infop info_ptr = nullptr;
         try
         {
             png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -77,47 +90,293 @@ namespace OpenLoco::Input
                 throw std::runtime_error("PNG ERROR");
             }
 
-            auto info_ptr = png_create_info_struct(png_ptr);
+            info_ptr = png_create_info_struct(png_ptr);
             if (info_ptr == nullptr)
                 throw std::runtime_error("png_create_info_struct failed.");
 
-            palette = (png_colorp)png_malloc(png_ptr, 246 * sizeof(png_color));
-            if (palette == nullptr)
-                throw std::runtime_error("png_malloc failed.");
-
-            for (size_t i = 0; i < 246; i++)
-            {
-                palette[i].blue = _113ED20[i][0];
-                palette[i].green = _113ED20[i][1];
-                palette[i].red = _113ED20[i][2];
-            }
-            png_set_PLTE(png_ptr, info_ptr, palette, 246);
-            auto& context = Gfx::screenContext();
+            png_set_PLTE(png_ptr, info_ptr, palette.data(), static_cast<int>(palette.size()));
 
             png_byte transparentIndex = 0;
             png_set_tRNS(png_ptr, info_ptr, &transparentIndex, 1, nullptr);
-            png_set_IHDR(png_ptr, info_ptr, context.width, context.height, 8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+            png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_PALETTE, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
             png_write_info(png_ptr, info_ptr);
 
-            uint8_t* data = context.bits;
-            for (int y = 0; y < context.height; y++)
+            for (int32_t y = 0; y < height; y++)
             {
-                png_write_row(png_ptr, data);
-                data += context.pitch + context.width;
+                png_write_row(png_ptr, nextRow());
             }
 
             png_write_end(png_ptr, nullptr);
-            png_destroy_info_struct(png_ptr, &info_ptr);
-            png_free(png_ptr, palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+            png_destroy_write_struct(&png_ptr, &info_ptr);
         }
         catch (const std::exception&)
         {
-            png_free(png_ptr, palette);
-            png_destroy_write_struct(&png_ptr, nullptr);
+            png_destroy_write_struct(&png_ptr, &info_ptr);
             throw;
         }
+    }
+
+    // Compresses rows handed over by the game thread on a worker thread. The rows arrive in blocks of
+    // whole rows, push blocks while the worker is behind so only a few blocks are held at once.
+    class ScreenshotJob
+    {
+    public:
+        ScreenshotJob(const fs::path& path, const std::string& fileName, int32_t width, int32_t height)
+            : _fileName(fileName)
+            , _width(width)
+            , _height(height)
+            , _palette(copyPalette())
+        {
+            _thread = std::thread([this, path]() { run(path); });
+        }
+
+        ~ScreenshotJob()
+        {
+            finish();
+            _thread.join();
+        }
+
+        void push(std::vector<uint8_t> rows)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _space.wait(lock, [this]() { return _blocks.size() < maxQueuedBlocks || _failed; });
+            if (_failed)
+            {
+                return;
+            }
+            _blocks.push_back(std::move(rows));
+            _available.notify_one();
+        }
+
+        void finish()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _finished = true;
+            _available.notify_one();
+        }
+
+        bool isDone() const
+        {
+            return _done;
+        }
+
+        ScreenshotResult getResult()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return { _fileName, !_failed };
+        }
+
+    private:
+        std::string _fileName;
+        int32_t _width;
+        int32_t _height;
+        Palette _palette;
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _available;
+        std::condition_variable _space;
+        std::deque<std::vector<uint8_t>> _blocks;
+        std::vector<uint8_t> _current;
+        size_t _currentOffset = 0;
+        bool _finished = false;
+        bool _failed = false;
+        std::atomic<bool> _done{ false };
+
+        void run(const fs::path& path)
+        {
+            try
+            {
+                encodePng(path, _width, _height, _palette, [this]() { return nextRow(); });
+            }
+            catch (const std::exception& e)
+            {
+                Console::error("Unable to save screenshot: %s", e.what());
+
+                // Don't leave the reserved file behind
+                std::error_code ec;
+                fs::remove(path, ec);
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                _failed = true;
+                _space.notify_one();
+            }
+            _done = true;
+        }
+
+        const uint8_t* nextRow()
+        {
+            if (_currentOffset >= _current.size())
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _available.wait(lock, [this]() { return !_blocks.empty() || _finished; });
+                if (_blocks.empty())
+                {
+                    throw std::runtime_error("Screenshot ended before its last row");
+                }
+                _current = std::move(_blocks.front());
+                _blocks.pop_front();
+                _currentOffset = 0;
+                _space.notify_one();
+            }
+
+            const auto* row = _current.data() + _currentOffset;
+            _currentOffset += _width;
+            return row;
+        }
+    };
+
+    static std::vector<std::unique_ptr<ScreenshotJob>> _jobs;
+
+    // Picks the first free file name and creates the file so the next screenshot can't pick it too
+    static std::string reserveFileName(fs::path& path)
+    {
+        auto basePath = platform::getUserDirectory();
+        std::string scenarioName = S5::getOptions().scenarioName;
+
+        if (scenarioName.length() == 0)
+            scenarioName = StringManager::getString(StringIds::screenshot_filename_template);
+
+        std::string fileName = std::string(scenarioName) + ".png";
+        int16_t suffix;
+        for (suffix = 1; suffix <= std::numeric_limits<int16_t>().max(); suffix++)
+        {
+            if (!fs::exists(basePath / fileName))
+            {
+                path = basePath / fileName;
+                break;
+            }
+
+            fileName = std::string(scenarioName) + " (" + std::to_string(suffix) + ").png";
+        }
+
+        if (path.empty())
+        {
+            throw std::runtime_error("Failed finding filename");
+        }
+
+        std::fstream reservation(path.c_str(), std::ios::out | std::ios::binary);
+        if (!reservation)
+        {
+            throw std::runtime_error("Failed creating file");
+        }
 
         return fileName;
     }
+
+    // 0x00452667
+    std::string saveScreenshot()
+    {
+        fs::path path;
+        auto fileName = reserveFileName(path);
+
+        // Copy the frame without the row padding, the worker must not read the live screen
+        auto& context = Gfx::screenContext();
+        std::vector<uint8_t> pixels(context.width * context.height);
+        for (int32_t y = 0; y < context.height; y++)
+        {
+            std::memcpy(pixels.data() + y * context.width, context.bits + y * (context.width + context.pitch), context.width);
+        }
+
+        auto& job = *_jobs.emplace_back(std::make_unique<ScreenshotJob>(path, fileName, context.width, context.height));
+        job.push(std::move(pixels));
+        job.finish();
+
+        return fileName;
+    }
+
+    // Bounds of the whole map in view coordinates at the given rotation
+    static ViewportRect getMapViewBounds(int32_t rotation)
+    {
+        const Map::Pos3 corners[] = {
+            { 0, 0, 0 },
+            { Map::map_width, 0, 0 },
+            { 0, Map::map_height, 0 },
+            { Map::map_width, Map::map_height, 0 },
+        };
+
+        ViewportRect bounds;
+        bounds.left = std::numeric_limits<int16_t>::max();
+        bounds.top = std::numeric_limits<int16_t>::max();
+        bounds.right = std::numeric_limits<int16_t>::min();
+        bounds.bottom = std::numeric_limits<int16_t>::min();
+        for (const auto& corner : corners)
+        {
+            const auto pos = Viewport::mapFrom3d(corner, rotation);
+            bounds.left = std::min(bounds.left, pos.x);
+            bounds.top = std::min(bounds.top, pos.y);
+            bounds.right = std::max(bounds.right, pos.x);
+            bounds.bottom = std::max(bounds.bottom, pos.y);
+        }
+        bounds.top -= maxSpriteHeight;
+        return bounds;
+    }
+
+    // Paints the whole map at the current rotation one strip of tiles at a time, each strip is handed to the
+    // encoder as soon as it is done. Painting uses the original game's paint session so it stays on the game thread.
+    std::string saveGiantScreenshot(uint8_t zoom)
+    {
+        fs::path path;
+        auto fileName = reserveFileName(path);
+
+        Viewport viewport{};
+        const auto bounds = getMapViewBounds(viewport.getRotation());
+        const int32_t width = (bounds.right - bounds.left) >> zoom;
+        const int32_t height = (bounds.bottom - bounds.top) >> zoom;
+        auto& job = *_jobs.emplace_back(std::make_unique<ScreenshotJob>(path, fileName, width, height));
+
+        Ui::setCursor(Ui::CursorId::busy);
+
+        viewport.zoom = zoom;
+
+        auto* mainViewport = WindowManager::getMainViewport();
+        if (mainViewport != nullptr)
+        {
+            viewport.flags = mainViewport->flags;
+        }
+
+        for (int32_t stripTop = 0; stripTop < height; stripTop += giantTileSize)
+        {
+            const auto stripHeight = std::min(giantTileSize, height - stripTop);
+            std::vector<uint8_t> strip(width * stripHeight);
+            for (int32_t tileLeft = 0; tileLeft < width; tileLeft += giantTileSize)
+            {
+                const auto tileWidth = std::min(giantTileSize, width - tileLeft);
+                viewport.width = tileWidth;
+                viewport.height = stripHeight;
+                viewport.view_x = bounds.left + (tileLeft << zoom);
+                viewport.view_y = bounds.top + (stripTop << zoom);
+                viewport.view_width = tileWidth << zoom;
+                viewport.view_height = stripHeight << zoom;
+
+                Gfx::Context context{};
+                context.bits = strip.data() + tileLeft;
+                context.width = tileWidth;
+                context.height = stripHeight;
+                context.pitch = width - tileWidth;
+                viewport.render(&context);
+            }
+            job.push(std::move(strip));
+        }
+        job.finish();
+
+        Ui::setCursor(Ui::CursorId::pointer);
+
+        return fileName;
+    }
+
+    std::vector<ScreenshotResult> takeFinishedScreenshots()
+    {
+        std::vector<ScreenshotResult> results;
+        for (auto it = _jobs.begin(); it != _jobs.end();)
+        {
+            if (!(*it)->isDone())
+            {
+                it++;
+                continue;
+            }
+            results.push_back((*it)->getResult());
+            it = _jobs.erase(it);
+        }
+        return results;
+    }
 }
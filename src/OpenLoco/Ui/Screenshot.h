@@ -1,7 +1,21 @@
+#pragma once
+
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace OpenLoco::Input
 {
+    struct ScreenshotResult
+    {
+        std::string fileName;
+        bool success;
+    };
+
+    // Both return the file name straight away, the png is compressed and written on a worker thread
     std::string saveScreenshot();
+    std::string saveGiantScreenshot(uint8_t zoom);
+
+    // Screenshots whose worker has finished since the last call
+    std::vector<ScreenshotResult> takeFinishedScreenshots();
 }
@@ -217,6 +217,7 @@ namespace OpenLoco::Ui::Windows
     namespace ObjectSelectionWindow
     {
         Window* open();
+        bool handleInput(uint32_t charCode, uint32_t keyCode);
     }
 
     namespace Options
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace OpenLoco::Utility
+{
+    // Calls func(i) for every i in [begin, end), splitting the range into one contiguous block per hardware thread.
+    template<typename TFunc>
+    void parallelFor(int32_t begin, int32_t end, TFunc&& func)
+    {
+        const auto count = end - begin;
+        if (count <= 0)
+        {
+            return;
+        }
+
+        const auto numThreads = std::clamp<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()), 1, count);
+        if (numThreads == 1)
+        {
+            for (auto i = begin; i < end; i++)
+            {
+                func(i);
+            }
+            return;
+        }
+
+        const auto blockSize = (count + numThreads - 1) / numThreads;
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        for (auto blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+        {
+            const auto blockEnd = std::min(blockBegin + blockSize, end);
+            threads.emplace_back([&func, blockBegin, blockEnd]() {
+                for (auto i = blockBegin; i < blockEnd; i++)
+                {
+                    func(i);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
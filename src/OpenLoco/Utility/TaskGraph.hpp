@@ -0,0 +1,189 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace OpenLoco::Utility
+{
+    // Runs a set of tasks, each once all of its dependencies have finished. Worker tasks get a thread each, main
+    // thread tasks run in the order they were added from run(), which calls idle while it waits for workers.
+    class TaskGraph
+    {
+    public:
+        using Clock = std::chrono::high_resolution_clock;
+        using TaskId = size_t;
+
+        struct Task
+        {
+            const char* name;
+            bool mainThread;
+            std::function<void()> func;
+            std::vector<TaskId> dependencies;
+            Clock::time_point startTime;
+            Clock::time_point endTime;
+            bool started = false;
+            bool finished = false;
+            bool failed = false;
+        };
+
+        TaskId add(const char* name, bool mainThread, std::function<void()> func, std::initializer_list<TaskId> dependencies = {})
+        {
+            auto& task = _tasks.emplace_back();
+            task.name = name;
+            task.mainThread = mainThread;
+            task.func = std::move(func);
+            task.dependencies = dependencies;
+            return _tasks.size() - 1;
+        }
+
+        // Rethrows the first exception thrown by a task once all started tasks have finished
+        void run(const std::function<void()>& idle)
+        {
+            _startTime = Clock::now();
+            std::vector<std::thread> workers;
+            std::exception_ptr error;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                if (_error != nullptr && error == nullptr)
+                {
+                    error = _error;
+                }
+
+                size_t numRunning = 0;
+                size_t numFinished = 0;
+                Task* mainTask = nullptr;
+                for (auto& task : _tasks)
+                {
+                    if (task.finished || task.failed)
+                    {
+                        numFinished++;
+                        continue;
+                    }
+                    if (task.started)
+                    {
+                        numRunning++;
+                        continue;
+                    }
+                    if (error != nullptr || !isReady(task))
+                    {
+                        continue;
+                    }
+
+                    if (task.mainThread)
+                    {
+                        if (mainTask == nullptr)
+                        {
+                            mainTask = &task;
+                        }
+                        continue;
+                    }
+
+                    task.started = true;
+                    task.startTime = Clock::now();
+                    numRunning++;
+                    workers.emplace_back([this, &task]() { runTask(task); });
+                }
+
+                if (mainTask != nullptr)
+                {
+                    mainTask->started = true;
+                    mainTask->startTime = Clock::now();
+                    lock.unlock();
+                    runTask(*mainTask);
+                    lock.lock();
+                    continue;
+                }
+
+                if (numRunning == 0)
+                {
+                    // Either every task has finished, or the rest depend on a task that failed
+                    if (numFinished != _tasks.size() && error == nullptr)
+                    {
+                        error = std::make_exception_ptr(std::logic_error("TaskGraph: unresolvable task dependencies"));
+                    }
+                    break;
+                }
+
+                lock.unlock();
+                idle();
+                lock.lock();
+                _finished.wait_for(lock, std::chrono::milliseconds(10));
+            }
+            lock.unlock();
+
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+            _endTime = Clock::now();
+
+            if (error != nullptr)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+        const std::vector<Task>& tasks() const { return _tasks; }
+        Clock::time_point startTime() const { return _startTime; }
+        Clock::time_point endTime() const { return _endTime; }
+
+    private:
+        std::vector<Task> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _finished;
+        std::exception_ptr _error;
+        Clock::time_point _startTime;
+        Clock::time_point _endTime;
+
+        bool isReady(const Task& task) const
+        {
+            for (auto dependency : task.dependencies)
+            {
+                if (!_tasks[dependency].finished)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void runTask(Task& task)
+        {
+            std::exception_ptr error;
+            try
+            {
+                task.func();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            task.endTime = Clock::now();
+            if (error == nullptr)
+            {
+                task.finished = true;
+            }
+            else
+            {
+                task.failed = true;
+                if (_error == nullptr)
+                {
+                    _error = error;
+                }
+            }
+            _finished.notify_all();
+        }
+    };
+}
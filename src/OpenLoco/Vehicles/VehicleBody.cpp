@@ -2,6 +2,7 @@
 #include "../Config.h"
 #include "../Entities/EntityManager.h"
 #include "../Entities/Misc.h"
+#include "../Entities/ParticleManager.h"
 #include "../Graphics/Gfx.h"
 #include "../Interop/Interop.hpp"
 #include "../Map/TileManager.h"
@@ -949,7 +950,7 @@ namespace OpenLoco::Vehicles
 
         auto smokeLoc = bogieDifference * var_05 / 128 + frontBogie->position + Map::Pos3(xyFactor.x, xyFactor.y, vehicleObject->animation[num].height);
 
-        Exhaust::create(smokeLoc, vehicleObject->animation[num].object_id | (soundCode ? 0 : 0x80));
+        ParticleManager::createExhaust(smokeLoc, vehicleObject->animation[num].object_id | (soundCode ? 0 : 0x80));
         if (soundCode == false)
             return;
 
@@ -1074,7 +1075,7 @@ namespace OpenLoco::Vehicles
             auto xyFactor = Math::Trigonometry::computeXYVector(positionFactor, invertedDirection) / 2;
 
             Map::Pos3 loc = position + Map::Pos3(xyFactor.x, xyFactor.y, vehicleObject->animation[num].height);
-            Exhaust::create(loc, vehicleObject->animation[num].object_id);
+            ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
         }
         else
         {
@@ -1098,7 +1099,7 @@ namespace OpenLoco::Vehicles
 
             auto loc = bogieDifference * var_05 / 128 + frontBogie->position + Map::Pos3(xyFactor.x, xyFactor.y, vehicleObject->animation[num].height);
 
-            Exhaust::create(loc, vehicleObject->animation[num].object_id);
+            ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
         }
     }
 
@@ -1147,7 +1148,7 @@ namespace OpenLoco::Vehicles
         loc.x += xyFactor.x;
         loc.y += xyFactor.y;
 
-        Exhaust::create(loc, vehicleObject->animation[num].object_id);
+        ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
     }
 
     // 0x004ABDAD & 0x004AB3CA
@@ -1184,7 +1185,7 @@ namespace OpenLoco::Vehicles
 
         auto loc = bogieDifference * var_05 / 128 + frontBogie->position + Map::Pos3(xyFactor.x, xyFactor.y, vehicleObject->animation[num].height);
 
-        Exhaust::create(loc, vehicleObject->animation[num].object_id);
+        ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
     }
 
     // 0x004ABEC3 & 0x004AB4E0
@@ -1239,7 +1240,7 @@ namespace OpenLoco::Vehicles
         loc.x += xyFactor.x;
         loc.y += xyFactor.y;
 
-        Exhaust::create(loc, vehicleObject->animation[num].object_id);
+        ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
     }
 
     // 0x004ABC8A & 0x004AB2A7
@@ -1284,7 +1285,7 @@ namespace OpenLoco::Vehicles
         loc.x += xyFactor.x;
         loc.y += xyFactor.y;
 
-        Exhaust::create(loc, vehicleObject->animation[num].object_id);
+        ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
 
         if (vehicleObject->var_113 == 0)
             return;
@@ -1296,7 +1297,7 @@ namespace OpenLoco::Vehicles
         loc.x += xyFactor.x;
         loc.y += xyFactor.y;
 
-        Exhaust::create(loc, vehicleObject->animation[num].object_id);
+        ParticleManager::createExhaust(loc, vehicleObject->animation[num].object_id);
     }
 
     // 0x004AC039
@@ -6,6 +6,7 @@
 #include "../Economy/Economy.h"
 #include "../Entities/EntityManager.h"
 #include "../Entities/Misc.h"
+#include "../Entities/ParticleManager.h"
 #include "../GameCommands/GameCommands.h"
 #include "../Graphics/Gfx.h"
 #include "../IndustryManager.h"
@@ -161,7 +162,7 @@ namespace OpenLoco::Vehicles
                 {
                     auto v2 = car.body; // body
 
-                    Smoke::create(v2->position + Map::Pos3{ 0, 0, 4 });
+                    ParticleManager::createSmoke(v2->position + Map::Pos3{ 0, 0, 4 });
                 }
             }
 
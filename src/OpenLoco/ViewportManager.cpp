@@ -184,7 +184,7 @@ namespace OpenLoco::Ui::ViewportManager
         return viewport;
     }
 
-    static void invalidate(const ViewportRect& rect, ZoomLevel zoom)
+    void invalidate(const ViewportRect& rect, ZoomLevel zoom)
     {
         bool doGarbageCollect = false;
 
@@ -390,10 +390,12 @@ namespace OpenLoco::Ui::ViewportManager
                 invalidate((EntityBase*)regs.esi, ZoomLevel::full);
                 return 0;
             });
+        // The original game invalidates the tiles it changes, the tree and water counts are kept up to date from these
         registerHook(
             0x004CBE5F,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 Map::TileManager::mapInvalidateTileFull(pos);
                 return 0;
             });
@@ -401,6 +403,7 @@ namespace OpenLoco::Ui::ViewportManager
             0x004CBFBF,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 invalidate(pos, regs.di, regs.si, ZoomLevel::eighth, 56);
                 return 0;
             });
@@ -408,6 +411,7 @@ namespace OpenLoco::Ui::ViewportManager
             0x004CC098,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 invalidate(pos, regs.di, regs.si, ZoomLevel::eighth);
                 return 0;
             });
@@ -415,6 +419,7 @@ namespace OpenLoco::Ui::ViewportManager
             0x004CC20F,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 invalidate(pos, regs.di, regs.si, ZoomLevel::full);
                 return 0;
             });
@@ -422,6 +427,7 @@ namespace OpenLoco::Ui::ViewportManager
             0x004CC390,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 invalidate(pos, regs.di, regs.si, ZoomLevel::half);
                 return 0;
             });
@@ -429,6 +435,7 @@ namespace OpenLoco::Ui::ViewportManager
             0x004CC511,
             [](registers& regs) FORCE_ALIGN_ARG_POINTER -> uint8_t {
                 auto pos = Map::Pos2(regs.ax, regs.cx);
+                Map::TileManager::invalidateNeighbourhoodCounts(pos);
                 invalidate(pos, regs.di, regs.si, ZoomLevel::quarter);
                 return 0;
             });
@@ -142,7 +142,7 @@ namespace OpenLoco::Ui::Windows::CompanyFaceSelection
     static ObjectManager::ObjIndexPair getObjectFromSelection(const int16_t& y)
     {
         const int16_t rowIndex = y / rowHeight;
-        const auto objects = ObjectManager::getAvailableObjects(ObjectType::competitor);
+        const auto& objects = ObjectManager::getAvailableObjects(ObjectType::competitor);
         if (rowIndex < 0 || static_cast<uint16_t>(rowIndex) >= objects.size())
         {
             return { -1, ObjectManager::ObjectIndexEntry{} };
@@ -14,13 +14,15 @@
 #include "../Ui/Dropdown.h"
 #include "../Ui/WindowManager.h"
 #include "../Widget.h"
+#include <cstdlib>
+#include <limits>
 
 using namespace OpenLoco::Interop;
 
 namespace OpenLoco::Ui::Windows::LandscapeGeneration
 {
     static const Gfx::ui_size_t window_size = { 366, 217 };
-    static const Gfx::ui_size_t land_tab_size = { 366, 247 };
+    static const Gfx::ui_size_t land_tab_size = { 366, 262 };
 
     static const uint8_t rowHeight = 22; // CJK: 22
 
@@ -339,6 +341,7 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
         {
             generator = 9,
             generator_btn,
+            seed,
             sea_level,
             sea_level_down,
             sea_level_up,
@@ -354,18 +357,19 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
             scrollview,
         };
 
-        const uint64_t enabled_widgets = Common::enabled_widgets | (1 << widx::generator) | (1 << widx::generator_btn) | (1 << widx::sea_level_up) | (1 << widx::sea_level_down) | (1 << widx::min_land_height_up) | (1 << widx::min_land_height_down) | (1 << widx::topography_style) | (1 << widx::topography_style_btn) | (1 << widx::hill_density_up) | (1 << widx::hill_density_down) | (1 << widx::hills_edge_of_map);
+        const uint64_t enabled_widgets = Common::enabled_widgets | (1 << widx::generator) | (1 << widx::generator_btn) | (1 << widx::seed) | (1 << widx::sea_level_up) | (1 << widx::sea_level_down) | (1 << widx::min_land_height_up) | (1 << widx::min_land_height_down) | (1 << widx::topography_style) | (1 << widx::topography_style_btn) | (1 << widx::hill_density_up) | (1 << widx::hill_density_down) | (1 << widx::hills_edge_of_map);
         const uint64_t holdable_widgets = (1 << widx::sea_level_up) | (1 << widx::sea_level_down) | (1 << widx::min_land_height_up) | (1 << widx::min_land_height_down) | (1 << widx::hill_density_up) | (1 << widx::hill_density_down);
 
         static Widget widgets[] = {
-            common_options_widgets(247, StringIds::title_landscape_generation_land),
+            common_options_widgets(262, StringIds::title_landscape_generation_land),
             makeDropdownWidgets({ 176, 52 }, { 180, 12 }, WidgetType::wt_18, WindowColour::secondary),
-            makeStepperWidgets({ 256, 67 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::sea_level_units),
-            makeStepperWidgets({ 256, 82 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::min_land_height_units),
-            makeDropdownWidgets({ 176, 97 }, { 180, 12 }, WidgetType::wt_18, WindowColour::secondary),
-            makeStepperWidgets({ 256, 112 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::hill_density_percent),
-            makeWidget({ 10, 128 }, { 346, 12 }, WidgetType::checkbox, WindowColour::secondary, StringIds::create_hills_right_up_to_edge_of_map),
-            makeWidget({ 4, 142 }, { 358, 100 }, WidgetType::scrollview, WindowColour::secondary, Scrollbars::vertical),
+            makeWidget({ 176, 67 }, { 180, 12 }, WidgetType::wt_17, WindowColour::secondary, StringIds::empty, StringIds::tooltip_landscape_seed),
+            makeStepperWidgets({ 256, 82 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::sea_level_units),
+            makeStepperWidgets({ 256, 97 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::min_land_height_units),
+            makeDropdownWidgets({ 176, 112 }, { 180, 12 }, WidgetType::wt_18, WindowColour::secondary),
+            makeStepperWidgets({ 256, 127 }, { 100, 12 }, WidgetType::wt_18, WindowColour::secondary, StringIds::hill_density_percent),
+            makeWidget({ 10, 143 }, { 346, 12 }, WidgetType::checkbox, WindowColour::secondary, StringIds::create_hills_right_up_to_edge_of_map),
+            makeWidget({ 4, 157 }, { 358, 100 }, WidgetType::scrollview, WindowColour::secondary, Scrollbars::vertical),
             widgetEnd()
         };
 
@@ -383,6 +387,13 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
                 Colour::black,
                 StringIds::generator);
 
+            Gfx::drawString_494B3F(
+                *context,
+                window->x + 10,
+                window->y + window->widgets[widx::seed].top,
+                Colour::black,
+                StringIds::landscape_seed);
+
             Gfx::drawString_494B3F(
                 *context,
                 window->x + 10,
@@ -605,9 +616,34 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
                     S5::getOptions().scenarioFlags ^= Scenario::flags::hills_edge_of_map;
                     window->invalidate();
                     break;
+
+                case widx::seed:
+                {
+                    // Offer the seed of the current landscape when a random one is set, so it can be kept
+                    const auto& options = S5::getOptions();
+                    const auto seed = options.seed != 0 ? options.seed : options.generatedSeed;
+                    *reinterpret_cast<uint32_t*>(&commonFormatArgs[0]) = seed;
+                    TextInput::openTextInput(window, StringIds::title_landscape_seed, StringIds::prompt_enter_landscape_seed, seed != 0 ? StringIds::landscape_seed_raw : StringIds::empty, widgetIndex, &*commonFormatArgs);
+                    break;
+                }
             }
         }
 
+        // An empty seed picks a new random one on each generation
+        static void textInput(Window* window, WidgetIndex_t callingWidget, const char* input)
+        {
+            if (callingWidget != widx::seed)
+                return;
+
+            char* end = nullptr;
+            const auto seed = std::strtoul(input, &end, 10);
+            if (*end != '\0' || seed > static_cast<unsigned long>(std::numeric_limits<int32_t>::max()))
+                return;
+
+            S5::getOptions().seed = static_cast<uint32_t>(seed);
+            window->invalidate();
+        }
+
         // 0x0043E421
         static int16_t scrollPosToLandIndex(int16_t xPos, int16_t yPos)
         {
@@ -661,6 +697,21 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
             commonFormatArgs[2] = options.hillDensity;
 
             window->widgets[widx::generator].text = generatorIds[static_cast<uint8_t>(options.generator)];
+
+            *reinterpret_cast<uint32_t*>(&commonFormatArgs[3]) = options.seed != 0 ? options.seed : options.generatedSeed;
+            if (options.seed != 0)
+                window->widgets[widx::seed].text = StringIds::landscape_seed_value;
+            else if (options.generatedSeed != 0)
+                window->widgets[widx::seed].text = StringIds::landscape_seed_random_last;
+            else
+                window->widgets[widx::seed].text = StringIds::landscape_seed_random;
+
+            // The original generator does not use the seed
+            if (options.generator == S5::LandGeneratorType::Original)
+                window->disabled_widgets |= (1 << widx::seed);
+            else
+                window->disabled_widgets &= ~(1 << widx::seed);
+
             window->widgets[widx::topography_style].text = topographyStyleIds[static_cast<uint8_t>(options.topographyStyle)];
 
             if ((options.scenarioFlags & Scenario::flags::hills_edge_of_map) != 0)
@@ -701,6 +752,7 @@ namespace OpenLoco::Ui::Windows::LandscapeGeneration
             events.on_mouse_up = onMouseUp;
             events.on_update = update;
             events.scroll_mouse_down = scrollMouseDown;
+            events.text_input = textInput;
             events.tooltip = tooltip;
         }
     }
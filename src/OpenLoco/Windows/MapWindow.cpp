@@ -1128,23 +1128,10 @@ namespace OpenLoco::Ui::Windows::MapWindow
     // 0x0046BFAD
     static void countVehiclesOnMap()
     {
+        const auto& counts = CompanyManager::getVehiclesOnMap();
         for (auto i = 0; i < 6; i++)
         {
-            _vehicleTypeCounts[i] = 0;
-        }
-
-        for (auto vehicle : EntityManager::VehicleList())
-        {
-            Vehicles::Vehicle train(vehicle);
-
-            if (train.head->var_38 & (1 << 4))
-                continue;
-
-            if (train.head->position.x == Location::null)
-                continue;
-
-            auto vehicleType = train.head->vehicleType;
-            _vehicleTypeCounts[static_cast<uint8_t>(vehicleType)] = _vehicleTypeCounts[static_cast<uint8_t>(vehicleType)] + 1;
+            _vehicleTypeCounts[i] = counts[i];
         }
     }
 
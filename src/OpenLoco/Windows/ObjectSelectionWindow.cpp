@@ -37,9 +37,12 @@
 #include "../Objects/VehicleObject.h"
 #include "../Objects/WallObject.h"
 #include "../Objects/WaterObject.h"
+#include "../Ui/TextInput.h"
 #include "../Ui/WindowManager.h"
 #include "../Widget.h"
+#include "../Win32.h"
 #include "../Window.h"
+#include <vector>
 
 using namespace OpenLoco::Interop;
 
@@ -81,6 +84,7 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
         advancedButton,
         scrollview,
         objectImage,
+        searchBox,
     };
 
     Widget widgets[] = {
@@ -90,13 +94,56 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
         makeWidget({ 0, 65 }, { 600, 333 }, WidgetType::panel, WindowColour::secondary),
         makeWidget({ 3, 15 }, { 589, 50 }, WidgetType::wt_5, WindowColour::secondary),
         makeWidget({ 470, 20 }, { 122, 12 }, WidgetType::wt_11, WindowColour::primary, StringIds::object_selection_advanced, StringIds::object_selection_advanced_tooltip),
-        makeWidget({ 4, 68 }, { 288, 317 }, WidgetType::scrollview, WindowColour::secondary, Scrollbars::vertical),
+        makeWidget({ 4, 84 }, { 288, 301 }, WidgetType::scrollview, WindowColour::secondary, Scrollbars::vertical),
         makeWidget({ 391, 68 }, { 114, 114 }, WidgetType::wt_9, WindowColour::secondary),
+        makeWidget({ 60, 68 }, { 232, 14 }, WidgetType::wt_17, WindowColour::secondary),
         widgetEnd(),
     };
 
     static WindowEventList _events;
 
+    // Name filter for the object list, typed into while the search box has focus
+    static Ui::TextInput::InputSession _searchInput;
+    static bool _searchFocused = false;
+    static std::vector<uint32_t> _searchResults; // Positions in ObjectManager::getAvailableObjects of the tab
+    static int16_t _searchResultsTab = -1;
+
+    static void setSearchFocus(Window* self, bool focused)
+    {
+        if (_searchFocused != focused)
+        {
+            _searchFocused = focused;
+            _searchInput.cursorFrame = 0;
+            self->invalidate();
+        }
+    }
+
+    static size_t getNumListedObjects(Window* self)
+    {
+        if (_searchInput.buffer.empty())
+        {
+            return ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab)).size();
+        }
+
+        if (_searchResultsTab != self->current_tab)
+        {
+            _searchResults = ObjectManager::searchAvailableObjects(static_cast<ObjectType>(self->current_tab), _searchInput.buffer);
+            _searchResultsTab = self->current_tab;
+        }
+        return _searchResults.size();
+    }
+
+    // The object shown on the given row of the list, which only lists objects matching the search
+    static const std::pair<uint32_t, ObjectManager::ObjectIndexEntry>* getListedObject(Window* self, size_t row)
+    {
+        const auto& objects = ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab));
+        if (row >= getNumListedObjects(self))
+            return nullptr;
+
+        const auto position = _searchInput.buffer.empty() ? row : _searchResults[row];
+        return position < objects.size() ? &objects[position] : nullptr;
+    }
+
     // 0x00473154
     static void sub_473154(Window* self)
     {
@@ -117,7 +164,7 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     // 0x00472BBC
     static ObjectManager::ObjIndexPair sub_472BBC(Window* self)
     {
-        const auto objects = ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab));
+        const auto& objects = ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab));
 
         for (auto [index, object] : objects)
         {
@@ -155,7 +202,7 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
 
         window = WindowManager::createWindowCentred(WindowType::objectSelection, { windowSize }, 0, &_events);
         window->widgets = widgets;
-        window->enabled_widgets = (1ULL << widx::closeButton) | (1ULL << widx::tabArea) | (1ULL << widx::advancedButton);
+        window->enabled_widgets = (1ULL << widx::closeButton) | (1ULL << widx::tabArea) | (1ULL << widx::advancedButton) | (1ULL << widx::searchBox);
         window->initScrollWidgets();
         window->frame_no = 0;
         window->row_hover = -1;
@@ -165,6 +212,10 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
 
         window->object = nullptr;
 
+        _searchInput = Ui::TextInput::InputSession("");
+        _searchFocused = false;
+        _searchResultsTab = -1;
+
         sub_473154(window);
         sub_4731EE(window, ObjectType::region);
         ObjectManager::freeScenarioText();
@@ -497,6 +548,35 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
         }
     }
 
+    static void drawSearchBox(Window* self, Gfx::Context* context)
+    {
+        loco_global<char[16], 0x0112C826> _commonFormatArgs;
+
+        const auto& widget = self->widgets[widx::searchBox];
+        Gfx::drawString_494B3F(*context, self->x + 4, self->y + widget.top + 2, 0, StringIds::object_selection_search, nullptr);
+
+        Gfx::Context* clipped = nullptr;
+        if (!Gfx::clipContext(&clipped, context, widget.left + 1 + self->x, widget.top + 1 + self->y, widget.width() - 2, widget.height() - 2))
+            return;
+
+        char* drawnBuffer = (char*)StringManager::getString(StringIds::buffer_2039);
+        strcpy(drawnBuffer, _searchInput.buffer.c_str());
+        *((string_id*)(&_commonFormatArgs[0])) = StringIds::buffer_2039;
+
+        Gfx::point_t position = { _searchInput.xOffset, 1 };
+        Gfx::drawString_494B3F(*clipped, &position, 0, StringIds::black_stringid, _commonFormatArgs);
+
+        if (!_searchFocused || (_searchInput.cursorFrame % 32) >= 16)
+            return;
+
+        strncpy(drawnBuffer, _searchInput.buffer.c_str(), _searchInput.cursorPosition);
+        drawnBuffer[_searchInput.cursorPosition] = '\0';
+
+        position = { _searchInput.xOffset, 1 };
+        Gfx::drawString_494B3F(*clipped, &position, 0, StringIds::black_stringid, _commonFormatArgs);
+        Gfx::fillRect(clipped, position.x, position.y, position.x, position.y + 9, Colour::getShade(self->getColour(WindowColour::secondary), 9));
+    }
+
     // 0x004733F5
     static void draw(Window* self, Gfx::Context* context)
     {
@@ -504,6 +584,7 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
         self->draw(context);
 
         drawTabs(self, context);
+        drawSearchBox(self, context);
 
         bool doDefault = true;
         if (self->object != nullptr)
@@ -592,10 +673,19 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
         if (ObjectManager::getNumInstalledObjects() == 0)
             return;
 
-        int y = 0;
-        auto objects = ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab));
-        for (auto [i, object] : objects)
+        // Only draw the visible rows
+        const auto numRows = getNumListedObjects(self);
+        const auto firstRow = std::max(0, context->y / rowHeight);
+        const auto lastRow = std::min<size_t>(numRows, (context->y + context->height) / rowHeight + 1);
+        for (size_t row = firstRow; row < lastRow; row++)
         {
+            const auto listed = getListedObject(self, row);
+            if (listed == nullptr)
+                break;
+
+            const auto y = static_cast<int>(row) * rowHeight;
+            const auto& [i, object] = *listed;
+
             uint8_t flags = (1 << 7) | (1 << 6) | (1 << 5);
             Gfx::fillRectInset(context, 2, y, 11, y + 10, self->getColour(WindowColour::secondary), flags);
 
@@ -638,7 +728,6 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
             _currentFontSpriteBase = Font::medium_bold;
 
             Gfx::drawString(context, 15, y, Colour::black, buffer);
-            y += rowHeight;
         }
     }
 
@@ -651,6 +740,11 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     // 0x004737BA
     static void onMouseUp(Window* self, WidgetIndex_t w)
     {
+        // The search box takes focus on mouse down, releasing the button over it must not drop it again
+        if (w != widx::searchBox)
+        {
+            setSearchFocus(self, false);
+        }
         switch (w)
         {
             case widx::closeButton:
@@ -733,7 +827,22 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     // 0x004738ED
     static void getScrollSize(Window* self, uint32_t scrollIndex, uint16_t* scrollWidth, uint16_t* scrollHeight)
     {
-        *scrollHeight = _tabObjectCounts[self->current_tab] * rowHeight;
+        if (_searchInput.buffer.empty())
+        {
+            *scrollHeight = _tabObjectCounts[self->current_tab] * rowHeight;
+        }
+        else
+        {
+            *scrollHeight = static_cast<uint16_t>(getNumListedObjects(self) * rowHeight);
+        }
+    }
+
+    static void onMouseDown(Window* self, WidgetIndex_t w)
+    {
+        if (w == widx::searchBox)
+        {
+            setSearchFocus(self, true);
+        }
     }
 
     // 0x00473900
@@ -747,14 +856,12 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     // 0x00472B54
     static ObjectManager::ObjIndexPair getObjectFromSelection(Window* self, int16_t& y)
     {
-        const auto objects = ObjectManager::getAvailableObjects(static_cast<ObjectType>(self->current_tab));
-
-        for (auto [index, object] : objects)
+        if (y >= 0)
         {
-            y -= rowHeight;
-            if (y < 0)
+            auto listed = getListedObject(self, y / rowHeight);
+            if (listed != nullptr)
             {
-                return { static_cast<int16_t>(index), object };
+                return { static_cast<int16_t>(listed->first), listed->second };
             }
         }
 
@@ -794,6 +901,7 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     // 0x00473948
     static void onScrollMouseDown(Ui::Window* self, int16_t x, int16_t y, uint8_t scroll_index)
     {
+        setSearchFocus(self, false);
         auto objIndex = getObjectFromSelection(self, y);
         auto index = objIndex.index;
         auto object = objIndex.object._header;
@@ -876,12 +984,56 @@ namespace OpenLoco::Ui::Windows::ObjectSelectionWindow
     static void onUpdate(Window* self)
     {
         WindowManager::invalidateWidget(WindowType::objectSelection, self->number, widx::objectImage);
+
+        if (_searchFocused)
+        {
+            _searchInput.cursorFrame++;
+            if ((_searchInput.cursorFrame % 16) == 0)
+            {
+                WindowManager::invalidateWidget(WindowType::objectSelection, self->number, widx::searchBox);
+            }
+        }
+    }
+
+    // Returns false when the search box does not have focus, leaving the key to shortcuts
+    bool handleInput(uint32_t charCode, uint32_t keyCode)
+    {
+        if (!_searchFocused)
+            return false;
+
+        auto self = WindowManager::find(WindowType::objectSelection);
+        if (self == nullptr)
+        {
+            _searchFocused = false;
+            return false;
+        }
+
+        if (keyCode == VK_RETURN || keyCode == VK_ESCAPE)
+        {
+            setSearchFocus(self, false);
+            return true;
+        }
+        if (!_searchInput.handleInput(charCode, keyCode))
+            return true;
+
+        _searchInput.cursorFrame = 0;
+        const auto containerWidth = self->widgets[widx::searchBox].width() - 2;
+        if (_searchInput.needsReoffsetting(containerWidth))
+        {
+            _searchInput.calculateTextOffset(containerWidth);
+        }
+
+        _searchResultsTab = -1;
+        self->scroll_areas[0].contentOffsetY = 0;
+        self->invalidate();
+        return true;
     }
 
     static void initEvents()
     {
         _events.on_close = onClose;
         _events.on_mouse_up = onMouseUp;
+        _events.on_mouse_down = onMouseDown;
         _events.on_update = onUpdate;
         _events.get_scroll_size = getScrollSize;
         _events.scroll_mouse_down = onScrollMouseDown;
@@ -32,8 +32,16 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 using namespace OpenLoco::Interop;
 
@@ -129,6 +137,205 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
 
     static std::vector<file_entry> _newFiles;
 
+    // Directories are listed on a worker thread and merged into the list by onUpdate, so slow or network
+    // drives do not freeze the window
+    struct DirectoryScan
+    {
+        std::mutex mutex;
+        std::vector<file_entry> entries; // Listed but not yet merged into _newFiles
+        bool finished = false;
+        std::atomic<bool> cancelled{ false };
+    };
+
+    static std::shared_ptr<DirectoryScan> _directoryScan;
+
+    // Decoded save previews keyed by path. Entries are loaded, and revalidated against the modification time of
+    // the file once per directory listing, on a worker thread.
+    class SaveDetailsCache
+    {
+    public:
+        static constexpr size_t maxEntries = 256;
+
+        ~SaveDetailsCache()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stopping = true;
+            }
+            _wake.notify_one();
+            if (_worker.joinable())
+            {
+                _worker.join();
+            }
+        }
+
+        // Returns the last details read for the path, queueing it to be read or revalidated if needed
+        std::shared_ptr<const S5::SaveDetails> get(const fs::path& path)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto& entry = touch(path.u8string(), true);
+            return entry.details;
+        }
+
+        // Urgent requests are read before any prefetched ones
+        void request(const fs::path& path, bool urgent)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            touch(path.u8string(), urgent);
+        }
+
+        // Revalidates each entry the next time it is requested
+        void invalidate()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto& entry : _entries)
+            {
+                entry.second.validated = false;
+            }
+        }
+
+        // Whether any entry has been read since the last call
+        bool takeChanged()
+        {
+            return _changed.exchange(false);
+        }
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<const S5::SaveDetails> details;
+            fs::file_time_type modified{};
+            uint32_t lastUsed = 0;
+            bool loaded = false;
+            bool validated = false;
+            bool queued = false;
+        };
+
+        std::unordered_map<std::string, Entry> _entries;
+        std::deque<std::string> _queue;
+        uint32_t _useCounter = 0;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::thread _worker;
+        bool _stopping = false;
+        std::atomic<bool> _changed{ false };
+
+        Entry& touch(const std::string& key, bool urgent)
+        {
+            auto it = _entries.find(key);
+            if (it == _entries.end())
+            {
+                evict();
+                it = _entries.emplace(key, Entry{}).first;
+            }
+
+            auto& entry = it->second;
+            entry.lastUsed = ++_useCounter;
+            if (entry.validated)
+            {
+                return entry;
+            }
+
+            if (entry.queued)
+            {
+                if (!urgent)
+                {
+                    return entry;
+                }
+                _queue.erase(std::find(_queue.begin(), _queue.end(), key));
+            }
+            entry.queued = true;
+            if (urgent)
+            {
+                _queue.push_front(key);
+            }
+            else
+            {
+                _queue.push_back(key);
+            }
+
+            if (!_worker.joinable())
+            {
+                _worker = std::thread([this]() { workerLoop(); });
+            }
+            _wake.notify_one();
+            return entry;
+        }
+
+        // Drops the least recently used entry that is not waiting to be read
+        void evict()
+        {
+            if (_entries.size() < maxEntries)
+            {
+                return;
+            }
+
+            auto oldest = _entries.end();
+            for (auto it = _entries.begin(); it != _entries.end(); it++)
+            {
+                if (!it->second.queued && (oldest == _entries.end() || it->second.lastUsed < oldest->second.lastUsed))
+                {
+                    oldest = it;
+                }
+            }
+            if (oldest != _entries.end())
+            {
+                _entries.erase(oldest);
+            }
+        }
+
+        void workerLoop()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;)
+            {
+                _wake.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+                if (_stopping)
+                {
+                    return;
+                }
+
+                auto key = std::move(_queue.front());
+                _queue.pop_front();
+                const auto& queued = _entries.at(key);
+                const auto loaded = queued.loaded;
+                const auto cachedModified = queued.modified;
+                lock.unlock();
+
+                const auto path = fs::u8path(key);
+                std::error_code ec;
+                const auto modified = fs::last_write_time(path, ec);
+                const auto reload = !loaded || ec || modified != cachedModified;
+                std::shared_ptr<const S5::SaveDetails> details;
+                if (reload)
+                {
+                    details = S5::readSaveDetails(path);
+                }
+
+                lock.lock();
+                auto& entry = _entries.at(key);
+                entry.queued = false;
+                entry.validated = true;
+                if (reload)
+                {
+                    entry.details = std::move(details);
+                    entry.modified = modified;
+                    entry.loaded = true;
+                    _changed = true;
+                }
+            }
+        }
+    };
+
+    static SaveDetailsCache& getSaveDetailsCache()
+    {
+        static SaveDetailsCache cache;
+        return cache;
+    }
+
+    static int16_t _prefetchFirstRow = -1;
+    static int16_t _prefetchNumFiles = -1;
+
     static void onClose(Window* window);
     static void onResize(Window* window);
     static void onMouseUp(Ui::Window* window, WidgetIndex_t widgetIndex);
@@ -148,6 +355,10 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
     static void processFileForLoadSave(Window* window);
     static void processFileForDelete(Window* self, file_entry& entry);
     static void refreshDirectoryList();
+    static void cancelDirectoryScan();
+    static void mergeDirectoryScan(Window* self);
+    static void prefetchSavePreviews(Window* self);
+    static fs::path getFilePath(const file_entry& entry);
     static void sub_446E87(Window* self);
     static bool filenameContainsInvalidChars();
 
@@ -243,6 +454,7 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
     // 0x0044647C
     static void onClose(Window*)
     {
+        cancelDirectoryScan();
         _newFiles = {};
         _numFiles = 0;
         _files = (file_entry*)-1;
@@ -283,6 +495,13 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
         {
             window->invalidate();
         }
+
+        mergeDirectoryScan(window);
+        prefetchSavePreviews(window);
+        if (getSaveDetailsCache().takeChanged())
+        {
+            window->invalidate();
+        }
     }
 
     // 0x004464A1
@@ -429,8 +648,9 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
         setCommonArgsStringptr(folder);
         Gfx::drawString_494B3F(*context, window->x + 3, window->y + window->widgets[widx::parent_button].top + 6, 0, StringIds::window_browse_folder, _commonFormatArgs);
 
+        // The hovered row may not have been listed yet after a refresh
         auto selectedIndex = window->var_85A;
-        if (selectedIndex != -1)
+        if (selectedIndex != -1 && selectedIndex < _numFiles)
         {
             auto& selectedFile = _files[selectedIndex];
             if (!selectedFile.is_directory())
@@ -455,9 +675,9 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
 
                 if (*_fileType == browse_file_type::saved_game)
                 {
-                    // Preview image
-                    auto saveInfo = *((const S5::SaveDetails**)0x50AEA8);
-                    if (saveInfo != (void*)-1)
+                    // Preview image, drawn once the cache has read it
+                    auto saveInfo = getSaveDetailsCache().get(getFilePath(selectedFile));
+                    if (saveInfo != nullptr)
                     {
                         drawSavePreview(*window, *context, x, y, width, 201, *saveInfo);
                     }
@@ -717,6 +937,71 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
         return baseName;
     }
 
+    static void sortFiles()
+    {
+        std::sort(_newFiles.begin(), _newFiles.end(), [](const file_entry& a, const file_entry& b) -> bool {
+            if (!a.is_directory() && b.is_directory())
+                return false;
+            if (a.is_directory() && !b.is_directory())
+                return true;
+            return a.get_name() < b.get_name();
+        });
+
+        _numFiles = (int16_t)_newFiles.size();
+        _files = _newFiles.data();
+    }
+
+    static void scanDirectory(DirectoryScan& scan, const fs::path& directory, const std::string& filterExtension)
+    {
+        // Hand entries over in batches to keep locking down
+        constexpr size_t batchSize = 32;
+        std::vector<file_entry> batch;
+        try
+        {
+            if (fs::is_directory(directory))
+            {
+                for (auto& f : fs::directory_iterator(directory))
+                {
+                    if (scan.cancelled)
+                    {
+                        return;
+                    }
+
+                    bool isDirectory = f.is_directory();
+                    if (f.is_regular_file())
+                    {
+                        auto extension = f.path().extension().u8string();
+                        if (!Utility::iequals(extension, filterExtension))
+                        {
+                            continue;
+                        }
+                    }
+                    else if (!isDirectory) // Only list directories or normal files
+                    {
+                        continue;
+                    }
+                    auto name = f.path().stem().u8string();
+                    batch.emplace_back(name, isDirectory);
+
+                    if (batch.size() >= batchSize)
+                    {
+                        std::lock_guard<std::mutex> lock(scan.mutex);
+                        scan.entries.insert(scan.entries.end(), batch.begin(), batch.end());
+                        batch.clear();
+                    }
+                }
+            }
+        }
+        catch (const fs::filesystem_error& err)
+        {
+            Console::error("Invalid directory or file: %s", err.what());
+        }
+
+        std::lock_guard<std::mutex> lock(scan.mutex);
+        scan.entries.insert(scan.entries.end(), batch.begin(), batch.end());
+        scan.finished = true;
+    }
+
     // 0x00446A93
     static void refreshDirectoryList()
     {
@@ -728,6 +1013,10 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
             filterExtension = filterExtension.substr(1);
         }
 
+        cancelDirectoryScan();
+        getSaveDetailsCache().invalidate();
+        _prefetchFirstRow = -1;
+
         _newFiles.clear();
         if (_directory[0] == '\0')
         {
@@ -740,47 +1029,86 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
         }
         else
         {
-            auto directory = fs::u8path((char*)_directory);
-            if (fs::is_directory(directory))
+            auto scan = std::make_shared<DirectoryScan>();
+            _directoryScan = scan;
+            std::thread([scan, directory = fs::u8path((char*)_directory), filterExtension]() {
+                scanDirectory(*scan, directory, filterExtension);
+            }).detach();
+        }
+
+        sortFiles();
+    }
+
+    static void cancelDirectoryScan()
+    {
+        if (_directoryScan != nullptr)
+        {
+            _directoryScan->cancelled = true;
+            _directoryScan = nullptr;
+        }
+    }
+
+    // Adds the entries listed since the last call, keeping the hovered entry selected
+    static void mergeDirectoryScan(Window* self)
+    {
+        if (_directoryScan == nullptr)
+            return;
+
+        std::vector<file_entry> entries;
+        {
+            std::lock_guard<std::mutex> lock(_directoryScan->mutex);
+            entries.swap(_directoryScan->entries);
+            if (_directoryScan->finished)
             {
-                try
-                {
-                    for (auto& f : fs::directory_iterator(directory))
-                    {
-                        bool isDirectory = f.is_directory();
-                        if (f.is_regular_file())
-                        {
-                            auto extension = f.path().extension().u8string();
-                            if (!Utility::iequals(extension, filterExtension))
-                            {
-                                continue;
-                            }
-                        }
-                        else if (!isDirectory) // Only list directories or normal files
-                        {
-                            continue;
-                        }
-                        auto name = f.path().stem().u8string();
-                        _newFiles.emplace_back(name, isDirectory);
-                    }
-                }
-                catch (const fs::filesystem_error& err)
-                {
-                    Console::error("Invalid directory or file: %s", err.what());
-                }
+                _directoryScan = nullptr;
             }
         }
+        if (entries.empty())
+            return;
 
-        std::sort(_newFiles.begin(), _newFiles.end(), [](const file_entry& a, const file_entry& b) -> bool {
-            if (!a.is_directory() && b.is_directory())
-                return false;
-            if (a.is_directory() && !b.is_directory())
-                return true;
-            return a.get_name() < b.get_name();
-        });
+        std::optional<file_entry> hovered;
+        if (self->var_85A != -1 && self->var_85A < _numFiles)
+        {
+            hovered = _files[self->var_85A];
+        }
 
-        _numFiles = (int16_t)_newFiles.size();
-        _files = _newFiles.data();
+        _newFiles.insert(_newFiles.end(), entries.begin(), entries.end());
+        sortFiles();
+
+        if (hovered)
+        {
+            auto it = std::find_if(_newFiles.begin(), _newFiles.end(), [&hovered](const file_entry& entry) {
+                return entry.is_directory() == hovered->is_directory() && entry.get_name() == hovered->get_name();
+            });
+            self->var_85A = it != _newFiles.end() ? static_cast<int16_t>(it - _newFiles.begin()) : -1;
+        }
+        self->invalidate();
+    }
+
+    // Queues the previews of the visible rows and a page either side of them
+    static void prefetchSavePreviews(Window* self)
+    {
+        if (*_fileType != browse_file_type::saved_game || self->row_height == 0)
+            return;
+
+        const int16_t firstRow = self->scroll_areas[0].contentOffsetY / self->row_height;
+        if (firstRow == _prefetchFirstRow && _numFiles == _prefetchNumFiles)
+            return;
+
+        _prefetchFirstRow = firstRow;
+        _prefetchNumFiles = _numFiles;
+
+        const auto numVisibleRows = self->widgets[widx::scrollview].height() / self->row_height + 1;
+        const auto begin = std::max(0, firstRow - numVisibleRows);
+        const auto end = std::min<int32_t>(_numFiles, firstRow + numVisibleRows * 2);
+        auto& cache = getSaveDetailsCache();
+        for (auto i = begin; i < end; i++)
+        {
+            if (!_files[i].is_directory())
+            {
+                cache.request(getFilePath(_files[i]), false);
+            }
+        }
     }
 
     // 0x00446E2F
@@ -889,6 +1217,13 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
         }
     }
 
+    static fs::path getFilePath(const file_entry& entry)
+    {
+        auto path = fs::u8path(&_directory[0]) / fs::u8path(std::string(entry.get_name()));
+        path += getExtensionFromFileType(_fileType);
+        return path;
+    }
+
     // 0x00446574
     static void processFileForLoadSave(Window* self)
     {
@@ -991,11 +1326,21 @@ namespace OpenLoco::Ui::Windows::PromptBrowse
     }
 
     // 0x00446E87
-    // TODO: only called by this window -- implement.
     static void sub_446E87(Window* self)
     {
-        registers regs;
-        regs.esi = (int32_t)self;
-        call(0x00446E87, regs);
+        // Landscape previews are still loaded by the original code
+        if (*_fileType != browse_file_type::saved_game)
+        {
+            registers regs;
+            regs.esi = (int32_t)self;
+            call(0x00446E87, regs);
+            return;
+        }
+
+        addr<0x009DA285, uint8_t>() = 0;
+        if (self->var_85A == -1 || self->var_85A >= _numFiles || _files[self->var_85A].is_directory())
+            return;
+
+        getSaveDetailsCache().request(getFilePath(_files[self->var_85A]), true);
     }
 }
@@ -116,10 +116,11 @@ namespace OpenLoco::Ui::Windows::ToolbarTop::Editor
         Dropdown::add(3, StringIds::menu_about);
         Dropdown::add(4, StringIds::options);
         Dropdown::add(5, StringIds::menu_screenshot);
-        Dropdown::add(6, 0);
-        Dropdown::add(7, StringIds::menu_quit_to_menu);
-        Dropdown::add(8, StringIds::menu_exit_openloco);
-        Dropdown::showBelow(window, widgetIndex, 9, 0);
+        Dropdown::add(6, StringIds::menu_giant_screenshot);
+        Dropdown::add(7, 0);
+        Dropdown::add(8, StringIds::menu_quit_to_menu);
+        Dropdown::add(9, StringIds::menu_exit_openloco);
+        Dropdown::showBelow(window, widgetIndex, 10, 0);
         Dropdown::setHighlightedItem(1);
     }
 
@@ -156,12 +157,16 @@ namespace OpenLoco::Ui::Windows::ToolbarTop::Editor
                 break;
             }
 
-            case 7:
+            case 6:
+                Common::takeGiantScreenshot();
+                break;
+
+            case 8:
                 // Return to title screen
                 GameCommands::do_21(0, 1);
                 break;
 
-            case 8:
+            case 9:
                 // Exit to desktop
                 GameCommands::do_21(0, 2);
                 break;
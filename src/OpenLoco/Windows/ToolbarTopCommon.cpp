@@ -19,6 +19,7 @@
 #include "../StationManager.h"
 #include "../TownManager.h"
 #include "../Ui/Dropdown.h"
+#include "../Ui/Screenshot.h"
 #include "../Vehicles/Vehicle.h"
 #include "../Widget.h"
 #include <map>
@@ -129,6 +130,23 @@ namespace OpenLoco::Ui::Windows::ToolbarTop::Common
         Dropdown::setHighlightedItem(0);
     }
 
+    // Renders the whole map at the main viewport's zoom and rotation, zoom and rotate the main view to choose them
+    void takeGiantScreenshot()
+    {
+        auto viewport = WindowManager::getMainViewport();
+        if (viewport == nullptr)
+            return;
+
+        try
+        {
+            Input::saveGiantScreenshot(viewport->zoom);
+        }
+        catch (const std::exception&)
+        {
+            Windows::showError(StringIds::screenshot_failed);
+        }
+    }
+
     // 0x0043ADF6
     void viewMenuMouseDown(Window* window, WidgetIndex_t widgetIndex)
     {
@@ -51,5 +51,7 @@ namespace OpenLoco::Ui::Windows::ToolbarTop::Common
     void onMouseDown(Window* window, WidgetIndex_t widgetIndex);
     void onDropdown(Window* window, WidgetIndex_t widgetIndex, int16_t itemIndex);
 
+    void takeGiantScreenshot();
+
     void rightAlignTabs(Window* window, uint32_t& x, const std::initializer_list<uint32_t> widxs);
 }